@@ -0,0 +1,93 @@
+#ifndef CACHE_MISS_COUNTERS_HPP
+#define CACHE_MISS_COUNTERS_HPP
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// L1D and L2 read misses of the calling thread, through perf_event_open.
+// Where the kernel refuses the counters (containers, perf_event_paranoid) nothing is reported.
+// L2 has no generic perf event: last-level cache misses stand in for it, which is L2 on parts without L3
+// and an upper bound on L2 misses otherwise.
+class CacheMissCounters
+{
+public:
+    CacheMissCounters()
+        : l1dMisses(open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))),
+          llcMisses(open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                 (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)))
+    {
+    }
+
+    ~CacheMissCounters()
+    {
+        for (const int fd : {l1dMisses, llcMisses})
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+    }
+
+    CacheMissCounters(const CacheMissCounters &) = delete;
+    auto operator=(const CacheMissCounters &) -> CacheMissCounters & = delete;
+
+    // Counting runs between start and stop, across any number of pairs
+    void start() const { toggle(PERF_EVENT_IOC_ENABLE); }
+    void stop() const { toggle(PERF_EVENT_IOC_DISABLE); }
+
+    // Misses per processed item as benchmark counters
+    void report(benchmark::State &state, const double items) const
+    {
+        if (l1dMisses >= 0)
+        {
+            state.counters["L1D_miss/item"] = static_cast<double>(read(l1dMisses)) / items;
+        }
+        if (llcMisses >= 0)
+        {
+            state.counters["LLC_miss/item"] = static_cast<double>(read(llcMisses)) / items;
+        }
+    }
+
+private:
+    int l1dMisses;
+    int llcMisses;
+
+    static auto open(const std::uint32_t type, const std::uint64_t config) -> int
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static auto read(const int fd) -> std::uint64_t
+    {
+        std::uint64_t value = 0;
+        return (::read(fd, &value, sizeof(value)) == sizeof(value)) ? value : 0;
+    }
+
+    void toggle(const unsigned long request) const
+    {
+        for (const int fd : {l1dMisses, llcMisses})
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, request, 0);
+            }
+        }
+    }
+};
+
+#endif // CACHE_MISS_COUNTERS_HPP
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "benchmark_config.hpp"
+#include "EventLog.h"
+#include "InstrumentRegistry.hpp"
+#include "TradeFormat.h"
+
+namespace
+{
+    auto makeTrade(const InstrumentId instrument) -> Trade
+    {
+        Trade trade(1, 2, 3, instrument, 10025, 50, std::chrono::system_clock::now());
+        trade.setBuyOrderStatus(TradeStatus::SUCCESS);
+        trade.setSellOrderStatus(TradeStatus::PARTIALLY_FILLED);
+        return trade;
+    }
+
+    // Empties the calling thread's ring outside the timed region before it fills up
+    void drainEvery(benchmark::State &state, std::size_t &pending)
+    {
+        if (++pending == EventLog::RING_CAPACITY / 2)
+        {
+            state.PauseTiming();
+            EventLog::getInstance().drain();
+            pending = 0;
+            state.ResumeTiming();
+        }
+    }
+}
+
+// What the matching thread paid per message before: format the details and append them to the batch log
+static void BM_FormatOrderInline(benchmark::State &state)
+{
+    const InstrumentId instrument = InstrumentRegistry::getInstance().registerInstrument(BENCHMARK_Config::OrderBook::INSTRUMENT);
+    const Message message = Message::createAddOrderMessage(instrument, 10025, 50, true, OrderType::LIMIT);
+    std::string batchLog;
+    for (auto _ : state)
+    {
+        batchLog += message.addOrderDetails->toString();
+        batchLog += '\n';
+        if (batchLog.size() > (1 << 16))
+        {
+            batchLog.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatOrderInline);
+
+// What it pays now: copy one EventRecord into its ring
+static void BM_EventLogOrder(benchmark::State &state)
+{
+    const InstrumentId instrument = InstrumentRegistry::getInstance().registerInstrument(BENCHMARK_Config::OrderBook::INSTRUMENT);
+    const Message message = Message::createAddOrderMessage(instrument, 10025, 50, true, OrderType::LIMIT);
+    EventLog &eventLog = EventLog::getInstance();
+    std::size_t pending = 0;
+    for (auto _ : state)
+    {
+        eventLog.logMessage(message);
+        drainEvery(state, pending);
+    }
+    eventLog.drain();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventLogOrder);
+
+static void BM_FormatTradeInline(benchmark::State &state)
+{
+    const Trade trade = makeTrade(InstrumentRegistry::getInstance().registerInstrument(BENCHMARK_Config::OrderBook::INSTRUMENT));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(formatTrade(trade));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FormatTradeInline);
+
+static void BM_EventLogTrade(benchmark::State &state)
+{
+    const Trade trade = makeTrade(InstrumentRegistry::getInstance().registerInstrument(BENCHMARK_Config::OrderBook::INSTRUMENT));
+    EventLog &eventLog = EventLog::getInstance();
+    std::size_t pending = 0;
+    for (auto _ : state)
+    {
+        eventLog.logTrade(trade);
+        drainEvery(state, pending);
+    }
+    eventLog.drain();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventLogTrade);
@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <string>
+#include "benchmark_config.hpp"
+#include "InputJournal.h"
+#include "InstrumentRegistry.hpp"
+
+// Matching thread cost of journaling one message, committing every BATCH messages like the OrderManager does
+static void BM_InputJournalAppend(benchmark::State &state)
+{
+    constexpr std::size_t BATCH = 64;
+    const auto policy = static_cast<JournalSyncPolicy>(state.range(0));
+    const std::string path = (std::filesystem::temp_directory_path() / "input_journal_benchmark.journal").string();
+    std::filesystem::remove(path);
+
+    const InstrumentId instrument = InstrumentRegistry::getInstance().registerInstrument(BENCHMARK_Config::OrderBook::INSTRUMENT);
+    const Message message = Message::createAddOrderMessage(instrument, 10025, 50, true, OrderType::LIMIT);
+    {
+        // Sized for the whole run, so no growth is timed
+        InputJournal journal(path, policy, static_cast<std::size_t>(state.max_iterations));
+        std::size_t pending = 0;
+        std::uint32_t orderId = 0;
+        for (auto _ : state)
+        {
+            journal.append(message, ++orderId);
+            if (++pending == BATCH)
+            {
+                journal.commit();
+                pending = 0;
+            }
+        }
+        journal.commit();
+    }
+    std::filesystem::remove(path);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InputJournalAppend)
+    ->Arg(static_cast<int>(JournalSyncPolicy::NONE))
+    ->Arg(static_cast<int>(JournalSyncPolicy::PERIODIC))
+    ->Arg(static_cast<int>(JournalSyncPolicy::GROUP_COMMIT))
+    ->Iterations(1 << 20)
+    ->UseRealTime();
@@ -0,0 +1,192 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "benchmark_config.hpp"
+#include "LevelQueue.h"
+#include "Order.h"
+#include "SlabPool.hpp"
+
+using namespace BENCHMARK_Config::OrderBook;
+using namespace BENCHMARK_Config::PriceLevel;
+
+// Resting order the size of an Order, chained into its level through prev/next the way the book links Orders
+struct RestingOrder
+{
+    unsigned int id;
+    int quantity;
+    unsigned char cold[sizeof(Order) - 2 * sizeof(void *) - 8];
+    RestingOrder *prev = nullptr;
+    RestingOrder *next = nullptr;
+
+    RestingOrder(const unsigned int id, const int quantity) : id(id), quantity(quantity), cold{} {}
+};
+static_assert(sizeof(RestingOrder) == sizeof(Order));
+
+// The current level layout: a doubly linked list through the orders themselves
+class ListLevel
+{
+public:
+    using Handle = RestingOrder *;
+
+    auto push(RestingOrder *order) -> Handle
+    {
+        order->prev = tail;
+        order->next = nullptr;
+        (tail != nullptr ? tail->next : head) = order;
+        tail = order;
+        return order;
+    }
+
+    void cancel(const Handle order)
+    {
+        (order->prev != nullptr ? order->prev->next : head) = order->next;
+        (order->next != nullptr ? order->next->prev : tail) = order->prev;
+    }
+
+    // Fill quantity from the front, releasing completely filled makers
+    auto match(int quantity, SlabPool<RestingOrder> &pool) -> int
+    {
+        int filled = 0;
+        while (quantity > 0 && head != nullptr)
+        {
+            RestingOrder *maker = head;
+            const int traded = std::min(maker->quantity, quantity);
+            maker->quantity -= traded;
+            quantity -= traded;
+            filled += traded;
+            if (maker->quantity == 0)
+            {
+                head = maker->next;
+                (head != nullptr ? head->prev : tail) = nullptr;
+                pool.release(maker);
+            }
+        }
+        return filled;
+    }
+
+    template <typename OnMove>
+    void maintain(OnMove &&) {}
+
+private:
+    RestingOrder *head = nullptr;
+    RestingOrder *tail = nullptr;
+};
+
+// LevelQueue keeping the same orders as owners, which are only touched to release them
+class QueueLevel
+{
+public:
+    using Handle = LevelQueue::Position;
+
+    auto push(RestingOrder *order) -> Handle
+    {
+        return queue.push(order->id, order->quantity, reinterpret_cast<Order *>(order));
+    }
+
+    void cancel(const Handle position)
+    {
+        queue.cancel(position);
+    }
+
+    auto match(const int quantity, SlabPool<RestingOrder> &pool) -> int
+    {
+        return queue.match(quantity, [&pool](const LevelQueue::Entry &entry, int) {
+            if (entry.quantity == 0)
+            {
+                pool.release(reinterpret_cast<RestingOrder *>(entry.order));
+            }
+        });
+    }
+
+    template <typename OnMove>
+    void maintain(OnMove &&onMove)
+    {
+        if (queue.needsCompaction())
+        {
+            queue.compact(onMove);
+        }
+    }
+
+private:
+    LevelQueue queue;
+};
+
+// Allocate the makers of one level interleaved with those of other levels, so neighbours in a level
+// are LEVEL_STRIDE slots apart in the pool as on a busy book
+static auto restInterleaved(SlabPool<RestingOrder> &pool, const std::size_t depth) -> std::vector<RestingOrder *>
+{
+    std::vector<RestingOrder *> makers;
+    std::vector<RestingOrder *> others;
+    makers.reserve(depth);
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        makers.push_back(pool.acquire(static_cast<unsigned int>(i), ORDER_QUANTITY));
+        for (std::size_t j = 1; j < LEVEL_STRIDE; ++j)
+        {
+            others.push_back(pool.acquire(0U, ORDER_QUANTITY));
+        }
+    }
+    for (RestingOrder *other : others)
+    {
+        pool.release(other);
+    }
+    return makers;
+}
+
+// Take a whole level of `depth` makers with one aggressive order
+template <typename Level>
+static void BM_LevelSweep(benchmark::State &state)
+{
+    const auto depth = static_cast<std::size_t>(state.range(0));
+    SlabPool<RestingOrder> pool(depth * LEVEL_STRIDE);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        Level level;
+        for (RestingOrder *maker : restInterleaved(pool, depth))
+        {
+            level.push(maker);
+        }
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(level.match(static_cast<int>(depth) * ORDER_QUANTITY, pool));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long long>(depth));
+    state.counters["depth"] = static_cast<double>(depth);
+}
+BENCHMARK_TEMPLATE(BM_LevelSweep, ListLevel)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK_TEMPLATE(BM_LevelSweep, QueueLevel)->RangeMultiplier(8)->Range(64, 32768);
+
+// Cancel a random maker of a `depth` deep level and queue a replacement at the back.
+// The queue pays for its compactions here.
+template <typename Level>
+static void BM_LevelCancel(benchmark::State &state)
+{
+    const auto depth = static_cast<std::size_t>(state.range(0));
+    SlabPool<RestingOrder> pool(depth * LEVEL_STRIDE);
+    std::vector<RestingOrder *> makers = restInterleaved(pool, depth);
+    std::vector<typename Level::Handle> handles(depth);
+    Level level;
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        handles[i] = level.push(makers[i]);
+    }
+
+    std::mt19937 rng(42);
+    for (auto _ : state)
+    {
+        const std::size_t victim = rng() % depth;
+        level.cancel(handles[victim]);
+        pool.release(makers[victim]);
+
+        makers[victim] = pool.acquire(static_cast<unsigned int>(victim), ORDER_QUANTITY);
+        handles[victim] = level.push(makers[victim]);
+        level.maintain([&handles](const LevelQueue::Entry &entry, const auto position) {
+            handles[entry.orderId] = position;
+        });
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["depth"] = static_cast<double>(depth);
+}
+BENCHMARK_TEMPLATE(BM_LevelCancel, ListLevel)->RangeMultiplier(8)->Range(64, 32768);
+BENCHMARK_TEMPLATE(BM_LevelCancel, QueueLevel)->RangeMultiplier(8)->Range(64, 32768);
@@ -0,0 +1,4 @@
+#include <benchmark/benchmark.h>
+
+// Entry point for Google Benchmark
+BENCHMARK_MAIN();
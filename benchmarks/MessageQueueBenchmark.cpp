@@ -0,0 +1,181 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include "MessageQueue.h"
+
+// The queue as it was before the ring buffer: std::queue guarded by a mutex, consumer woken through a
+// condition variable on every push
+class LockedMessageQueue
+{
+public:
+    explicit LockedMessageQueue(std::size_t /*capacity*/, MessageQueue::ProducerMode /*producerMode*/) {}
+
+    void push(Message &&msg)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.emplace(std::move(msg));
+        }
+        condVar.notify_one();
+    }
+
+    bool pop(Message &msg)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        condVar.wait(lock, [this]() { return !queue.empty() || stopped; });
+        if (queue.empty())
+        {
+            return false;
+        }
+        msg = std::move(queue.front());
+        queue.pop();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable condVar;
+    std::queue<Message> queue;
+    bool stopped = false;
+};
+
+namespace
+{
+    constexpr std::size_t QUEUE_CAPACITY = 1 << 16;
+
+    // Payload-free messages, so the numbers measure the hand-off and not the allocator
+    Message makeMessage(const unsigned int clientId)
+    {
+        Message msg;
+        msg.type = MessageType::CANCEL_ORDER;
+        msg.client_id = clientId;
+        return msg;
+    }
+}
+
+// Producer threads push as fast as they can, thread 0 consumes everything they push
+template <typename Queue>
+static void BM_QueueThroughput(benchmark::State &state)
+{
+    static std::unique_ptr<Queue> queue;
+    static std::atomic<long> pushed{0};
+    const int producers = state.threads() - 1;
+
+    if (state.thread_index() == 0)
+    {
+        queue = std::make_unique<Queue>(QUEUE_CAPACITY, producers == 1 ? MessageQueue::ProducerMode::SINGLE
+                                                                       : MessageQueue::ProducerMode::MULTI);
+        pushed = 0;
+    }
+
+    long consumed = 0;
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+        {
+            // Consume what the producers push during this iteration
+            Message msg;
+            for (int i = 0; i < producers; ++i)
+            {
+                queue->pop(msg);
+                ++consumed;
+            }
+        }
+        else
+        {
+            queue->push(makeMessage(static_cast<unsigned int>(state.thread_index())));
+            pushed.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (state.thread_index() == 0)
+    {
+        // Drain what the producers pushed after the consumer left the timed loop
+        Message msg;
+        while (consumed < pushed.load())
+        {
+            queue->pop(msg);
+            ++consumed;
+        }
+        state.SetItemsProcessed(consumed);
+    }
+}
+BENCHMARK_TEMPLATE(BM_QueueThroughput, LockedMessageQueue)->Threads(2)->Threads(3)->Threads(5)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueThroughput, MessageQueue)->Threads(2)->Threads(3)->Threads(5)->UseRealTime();
+
+// Round trip through two queues between this thread and an echo thread, half of it is the one-way hand-off latency
+template <typename Queue>
+static void BM_QueuePingPong(benchmark::State &state)
+{
+    Queue request(QUEUE_CAPACITY, MessageQueue::ProducerMode::SINGLE);
+    Queue reply(QUEUE_CAPACITY, MessageQueue::ProducerMode::SINGLE);
+
+    std::thread echo([&]() {
+        Message msg;
+        while (request.pop(msg) && msg.type != MessageType::UNDEFINED)
+        {
+            reply.push(std::move(msg));
+        }
+    });
+
+    Message msg;
+    for (auto _ : state)
+    {
+        request.push(makeMessage(0));
+        reply.pop(msg);
+    }
+
+    request.push(Message{});
+    echo.join();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_QueuePingPong, LockedMessageQueue)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueuePingPong, MessageQueue)->UseRealTime();
+
+// Time from a push until the consumer holds the message, after the consumer has been idle for range(0) microseconds
+static void BM_WakeUpLatency(benchmark::State &state, const MessageQueue::WaitStrategy waitStrategy)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto idle = std::chrono::microseconds(state.range(0));
+    MessageQueue queue(QUEUE_CAPACITY, MessageQueue::ProducerMode::SINGLE, waitStrategy);
+    std::atomic<Clock::rep> receivedAt{0};
+
+    std::thread consumer([&]() {
+        Message msg;
+        while (queue.pop(msg))
+        {
+            receivedAt.store(Clock::now().time_since_epoch().count(), std::memory_order_release);
+        }
+    });
+
+    for (auto _ : state)
+    {
+        std::this_thread::sleep_for(idle);
+        receivedAt.store(0, std::memory_order_relaxed);
+
+        const Clock::time_point pushedAt = Clock::now();
+        queue.push(makeMessage(0));
+        Clock::rep received;
+        while ((received = receivedAt.load(std::memory_order_acquire)) == 0)
+        {
+        }
+        const auto latency = Clock::time_point(Clock::duration(received)) - pushedAt;
+        state.SetIterationTime(std::chrono::duration<double>(latency).count());
+    }
+
+    queue.shutdown();
+    consumer.join();
+}
+BENCHMARK_CAPTURE(BM_WakeUpLatency, busy_spin, MessageQueue::WaitStrategy::BUSY_SPIN)
+    ->Arg(10)->Arg(1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_WakeUpLatency, spin_yield, MessageQueue::WaitStrategy::SPIN_YIELD)
+    ->Arg(10)->Arg(1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_WakeUpLatency, spin_park, MessageQueue::WaitStrategy::SPIN_PARK)
+    ->Arg(10)->Arg(1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_WakeUpLatency, blocking, MessageQueue::WaitStrategy::BLOCKING)
+    ->Arg(10)->Arg(1000)->UseManualTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "benchmark_config.hpp"
+#include "CacheMissCounters.hpp"
+#include "ExecutionSink.h"
+#include "IDGenerator.hpp"
+#include "InstrumentRegistry.hpp"
+#include "MatchingEngine.h"
+#include "Order.h"
+
+using namespace BENCHMARK_Config::OrderBook;
+
+// Open the benchmark instrument's book and return its ID
+static InstrumentId createBook(MatchingEngine &engine)
+{
+    engine.createNewOrderBook(INSTRUMENT);
+    return InstrumentRegistry::getInstance().resolve(INSTRUMENT);
+}
+
+// Rest one bid per level, `spacing` ticks apart, starting at BASE_PRICE and going down
+static void fillBidLevels(MatchingEngine &engine, const InstrumentId instrument, const long long depth, const Price spacing)
+{
+    for (long long i = 0; i < depth; ++i)
+    {
+        const unsigned int orderId = IDGenerator::getInstance().getNextOrderID();
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(orderId, instrument, BASE_PRICE - i * spacing, ORDER_QUANTITY, true));
+    }
+}
+
+// Open and close a price level at `price`, the level insertion path of addLimitOrderToBook
+static void addAndCancelLevel(benchmark::State &state, MatchingEngine &engine, const InstrumentId instrument, const Price price)
+{
+    for (auto _ : state)
+    {
+        const unsigned int orderId = IDGenerator::getInstance().getNextOrderID();
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(orderId, instrument, price, ORDER_QUANTITY, true));
+        engine.cancelOrder(orderId, instrument);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// New level one tick behind the deepest level: the worst case for a walk from the best level
+static void BM_AddPriceLevelBehindBook(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+
+    const long long depth = state.range(0);
+    fillBidLevels(engine, instrument, depth, 1);
+
+    addAndCancelLevel(state, engine, instrument, BASE_PRICE - depth);
+    state.counters["levels"] = static_cast<double>(depth);
+}
+BENCHMARK(BM_AddPriceLevelBehindBook)->RangeMultiplier(4)->Range(16, 16384);
+
+// New level in an empty tick halfway down the book
+static void BM_AddPriceLevelInsideBook(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+
+    const long long depth = state.range(0);
+    fillBidLevels(engine, instrument, depth, 2);
+
+    addAndCancelLevel(state, engine, instrument, BASE_PRICE - 2 * (depth / 2) - 1);
+    state.counters["levels"] = static_cast<double>(depth);
+}
+BENCHMARK(BM_AddPriceLevelInsideBook)->RangeMultiplier(4)->Range(16, 16384);
+
+// Cancel a random resting order and replace it with a new one, keeping `depth` orders spread over 64 levels.
+// Stresses the order ID lookup on a book whose IDs keep moving forward.
+static void BM_CancelRestingOrder(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+
+    const auto depth = static_cast<std::size_t>(state.range(0));
+    std::vector<unsigned int> resting(depth);
+    for (std::size_t i = 0; i < depth; ++i)
+    {
+        resting[i] = IDGenerator::getInstance().getNextOrderID();
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(resting[i], instrument, BASE_PRICE - static_cast<Price>(i % 64), ORDER_QUANTITY, true));
+    }
+
+    std::mt19937 rng(42);
+    for (auto _ : state)
+    {
+        const std::size_t victim = rng() % depth;
+        engine.cancelOrder(resting[victim], instrument);
+
+        resting[victim] = IDGenerator::getInstance().getNextOrderID();
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(resting[victim], instrument, BASE_PRICE - static_cast<Price>(victim % 64), ORDER_QUANTITY, true));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["orders"] = static_cast<double>(depth);
+}
+BENCHMARK(BM_CancelRestingOrder)->RangeMultiplier(8)->Range(64, 262144);
+
+// Rest `levels` x `perLevel` orders on one side, levels one tick apart moving away from BASE_PRICE.
+// Orders go to the levels round-robin, so the makers of one level are spread through the order pool.
+// Returns the order IDs, the order at index i rests at level i % levels.
+static auto restOrders(MatchingEngine &engine, const InstrumentId instrument, const long long levels,
+                       const long long perLevel, const bool isBuy) -> std::vector<unsigned int>
+{
+    NullExecutionSink sink;
+    std::vector<unsigned int> orderIds;
+    orderIds.reserve(static_cast<std::size_t>(levels * perLevel));
+    for (long long i = 0; i < levels * perLevel; ++i)
+    {
+        const unsigned int orderId = IDGenerator::getInstance().getNextOrderID();
+        const Price price = isBuy ? BASE_PRICE - i % levels : BASE_PRICE + i % levels;
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(orderId, instrument, price, ORDER_QUANTITY, isBuy), sink);
+        orderIds.push_back(orderId);
+    }
+    return orderIds;
+}
+
+static void setBookCounters(benchmark::State &state)
+{
+    state.counters["levels"] = static_cast<double>(state.range(0));
+    state.counters["per_level"] = static_cast<double>(state.range(1));
+}
+
+// Book shapes shared by the hot path benchmarks: {levels} x {orders per level}
+static void bookShapes(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgsProduct({{1, 16, 256}, {1, 16, 256}})->ArgNames({"levels", "per_level"});
+}
+
+// Add a passive bid behind the orders of an existing level. The added orders are cancelled, untimed,
+// each time the book has doubled.
+static void BM_AddLimitOrder(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+    NullExecutionSink sink;
+
+    const long long levels = state.range(0);
+    const auto resting = static_cast<std::size_t>(levels * state.range(1));
+    restOrders(engine, instrument, levels, state.range(1), true);
+
+    std::vector<unsigned int> added;
+    added.reserve(resting);
+    for (auto _ : state)
+    {
+        const unsigned int orderId = IDGenerator::getInstance().getNextOrderID();
+        const Price price = BASE_PRICE - static_cast<Price>(added.size()) % levels;
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(orderId, instrument, price, ORDER_QUANTITY, true), sink);
+        added.push_back(orderId);
+
+        if (added.size() == resting)
+        {
+            state.PauseTiming();
+            for (const unsigned int id : added)
+            {
+                engine.cancelOrder(id, instrument);
+            }
+            added.clear();
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    setBookCounters(state);
+}
+BENCHMARK(BM_AddLimitOrder)->Apply(bookShapes);
+
+// Cancel resting orders in random order; once all are gone the book is rebuilt, untimed
+static void BM_CancelLimitOrder(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+    std::mt19937 rng(42);
+
+    std::vector<unsigned int> orderIds = restOrders(engine, instrument, state.range(0), state.range(1), true);
+    std::shuffle(orderIds.begin(), orderIds.end(), rng);
+    std::size_t next = 0;
+    for (auto _ : state)
+    {
+        engine.cancelOrder(orderIds[next], instrument);
+
+        if (++next == orderIds.size())
+        {
+            state.PauseTiming();
+            orderIds = restOrders(engine, instrument, state.range(0), state.range(1), true);
+            std::shuffle(orderIds.begin(), orderIds.end(), rng);
+            next = 0;
+            state.ResumeTiming();
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    setBookCounters(state);
+}
+BENCHMARK(BM_CancelLimitOrder)->Apply(bookShapes);
+
+// Change the quantity of a random resting order, the in-place path keeping time priority
+static void BM_ModifyQuantity(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+    std::mt19937 rng(42);
+
+    const long long levels = state.range(0);
+    const std::vector<unsigned int> orderIds = restOrders(engine, instrument, levels, state.range(1), true);
+    std::vector<int> quantities(orderIds.size(), ORDER_QUANTITY);
+    for (auto _ : state)
+    {
+        const std::size_t victim = rng() % orderIds.size();
+        quantities[victim] = (quantities[victim] == ORDER_QUANTITY) ? ORDER_QUANTITY + 1 : ORDER_QUANTITY;
+        engine.modifyOrder(orderIds[victim], instrument, BASE_PRICE - static_cast<Price>(victim) % levels, quantities[victim]);
+    }
+    state.SetItemsProcessed(state.iterations());
+    setBookCounters(state);
+}
+BENCHMARK(BM_ModifyQuantity)->Apply(bookShapes);
+
+// Move a random resting order between its level and a level `levels` ticks deeper, the cancel and
+// re-insert path of a price change
+static void BM_ModifyPrice(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+    std::mt19937 rng(42);
+
+    const long long levels = state.range(0);
+    const std::vector<unsigned int> orderIds = restOrders(engine, instrument, levels, state.range(1), true);
+    std::vector<bool> moved(orderIds.size(), false);
+    for (auto _ : state)
+    {
+        const std::size_t victim = rng() % orderIds.size();
+        moved[victim] = !moved[victim];
+        const Price price = BASE_PRICE - static_cast<Price>(victim) % levels - (moved[victim] ? levels : 0);
+        engine.modifyOrder(orderIds[victim], instrument, price, ORDER_QUANTITY);
+    }
+    state.SetItemsProcessed(state.iterations());
+    setBookCounters(state);
+}
+BENCHMARK(BM_ModifyPrice)->Apply(bookShapes);
+
+// Take a whole book side of `levels` x `per_level` asks with one market order. Reports the order layout
+// density and, where perf counters are available, cache misses per maker.
+static void BM_MatchSweep(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+    NullExecutionSink sink;
+    CacheMissCounters counters;
+
+    const long long makers = state.range(0) * state.range(1);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        restOrders(engine, instrument, state.range(0), state.range(1), false);
+        const unsigned int takerId = IDGenerator::getInstance().getNextOrderID();
+        Order *taker = engine.getOrderPool().createMarketOrder(takerId, instrument, static_cast<int>(makers) * ORDER_QUANTITY, true);
+        counters.start();
+        state.ResumeTiming();
+
+        engine.processNewOrder(taker, sink);
+
+        state.PauseTiming();
+        counters.stop();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * makers);
+    setBookCounters(state);
+    state.counters["order_bytes"] = static_cast<double>(sizeof(Order));
+    state.counters["orders/line"] = 64.0 / static_cast<double>(sizeof(Order));
+    counters.report(state, static_cast<double>(state.iterations() * makers));
+}
+BENCHMARK(BM_MatchSweep)->ArgsProduct({{1, 16, 256}, {16, 256, 1024}})->ArgNames({"levels", "per_level"})
+    ->Unit(benchmark::kMicrosecond);
+
+// End to end processNewOrder on a two-sided flow: a passive bid joins a random level, then a sell
+// limit order takes the order at the head of the best bid. The book keeps its size.
+static void BM_ProcessNewOrder(benchmark::State &state)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    const InstrumentId instrument = createBook(engine);
+    NullExecutionSink sink;
+    std::mt19937 rng(42);
+
+    const long long levels = state.range(0);
+    restOrders(engine, instrument, levels, state.range(1), true);
+    for (auto _ : state)
+    {
+        const Price bidPrice = BASE_PRICE - static_cast<Price>(rng() % levels);
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(IDGenerator::getInstance().getNextOrderID(), instrument, bidPrice, ORDER_QUANTITY, true), sink);
+        engine.processNewOrder(engine.getOrderPool().createLimitOrder(IDGenerator::getInstance().getNextOrderID(), instrument, BASE_PRICE - levels, ORDER_QUANTITY, false), sink);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+    setBookCounters(state);
+}
+BENCHMARK(BM_ProcessNewOrder)->Apply(bookShapes);
@@ -0,0 +1,92 @@
+#include <benchmark/benchmark.h>
+#include <fstream>
+#include <unordered_set>
+#include <unistd.h>
+#include "benchmark_config.hpp"
+#include "IDGenerator.hpp"
+#include "MatchingEngine.h"
+#include "OrderIdTracker.h"
+
+using namespace BENCHMARK_Config::OrderBook;
+
+namespace
+{
+    // Resident set size of the process, from /proc/self/statm
+    double residentMegabytes()
+    {
+        std::ifstream statm("/proc/self/statm");
+        long totalPages = 0;
+        long residentPages = 0;
+        statm >> totalPages >> residentPages;
+        return static_cast<double>(residentPages) * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+    }
+}
+
+// Duplicate detection as it was: one hash set entry per order ever seen
+static void BM_OrderIdSetInsert(benchmark::State &state)
+{
+    const auto count = static_cast<unsigned int>(state.range(0));
+    for (auto _ : state)
+    {
+        const double rssBefore = residentMegabytes();
+        std::unordered_set<unsigned int> seen;
+        for (unsigned int id = 1; id <= count; ++id)
+        {
+            seen.insert(id);
+        }
+        benchmark::DoNotOptimize(seen.count(count / 2));
+        state.counters["rss_growth_mb"] = residentMegabytes() - rssBefore;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OrderIdSetInsert)->RangeMultiplier(8)->Range(1 << 16, 1 << 25)->Unit(benchmark::kMillisecond);
+
+static void BM_OrderIdTrackerInsert(benchmark::State &state)
+{
+    const auto count = static_cast<unsigned int>(state.range(0));
+    for (auto _ : state)
+    {
+        const double rssBefore = residentMegabytes();
+        OrderIdTracker seen;
+        for (unsigned int id = 1; id <= count; ++id)
+        {
+            seen.insert(id);
+        }
+        benchmark::DoNotOptimize(seen.contains(count / 2));
+        state.counters["rss_growth_mb"] = residentMegabytes() - rssBefore;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_OrderIdTrackerInsert)->RangeMultiplier(8)->Range(1 << 16, 1 << 25)->Unit(benchmark::kMillisecond);
+
+// Soak: every iteration adds and cancels range(0) orders on one long-lived engine. The order IDs keep rising
+// through the whole run; RSS after the first iteration should stay flat.
+static void BM_EngineOrderIdSoak(benchmark::State &state)
+{
+    const auto ordersPerIteration = static_cast<int>(state.range(0));
+    MatchingEngine engine;
+    engine.createNewOrderBook(INSTRUMENT);
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve(INSTRUMENT);
+
+    double rssAfterFirst = 0;
+    bool first = true;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < ordersPerIteration; ++i)
+        {
+            const unsigned int id = IDGenerator::getInstance().getNextOrderID();
+            engine.processNewOrder(
+                engine.getOrderPool().createLimitOrder(id, instrument, BASE_PRICE + (i & 63), ORDER_QUANTITY, true));
+            engine.cancelOrder(id, instrument);
+        }
+        if (first)
+        {
+            rssAfterFirst = residentMegabytes();
+            first = false;
+        }
+    }
+    state.counters["rss_mb"] = residentMegabytes();
+    state.counters["rss_growth_mb"] = residentMegabytes() - rssAfterFirst;
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EngineOrderIdSoak)->Arg(1 << 20)->Iterations(16)->Unit(benchmark::kMillisecond);
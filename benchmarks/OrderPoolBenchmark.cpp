@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "benchmark_config.hpp"
+#include "InstrumentRegistry.hpp"
+#include "OrderPool.h"
+#include "TimestampUtility.h"
+
+using namespace BENCHMARK_Config::OrderBook;
+
+// Fields and construction work of an Order before pooling and symbol interning, allocated the way orders
+// used to be: one new/delete each
+struct HeapOrder
+{
+    unsigned int id;
+    std::string asset;
+    Price price;
+    int quantity;
+    bool is_buy;
+    OrderType type;
+    std::chrono::system_clock::time_point timestamp;
+
+    HeapOrder(const unsigned int id, std::string asset, const Price price, const int quantity, const bool is_buy)
+        : id(id), asset(std::move(asset)), price(price), quantity(quantity), is_buy(is_buy), type(OrderType::LIMIT),
+          timestamp(currentTimestamp())
+    {
+    }
+};
+
+// Create `live` orders, then retire them oldest first, as a book full of resting orders turning over would
+static void BM_HeapOrderChurn(benchmark::State &state)
+{
+    const auto live = static_cast<std::size_t>(state.range(0));
+    const std::string asset = INSTRUMENT;
+    std::vector<HeapOrder *> orders(live);
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < live; ++i)
+        {
+            orders[i] = new HeapOrder(static_cast<unsigned int>(i), asset, BASE_PRICE, ORDER_QUANTITY, true);
+        }
+        benchmark::DoNotOptimize(orders.data());
+        for (HeapOrder *order : orders)
+        {
+            delete order;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HeapOrderChurn)->RangeMultiplier(8)->Range(1, 32768);
+
+static void BM_PooledOrderChurn(benchmark::State &state)
+{
+    const auto live = static_cast<std::size_t>(state.range(0));
+    const InstrumentId instrument = InstrumentRegistry::getInstance().registerInstrument(INSTRUMENT);
+    std::vector<Order *> orders(live);
+    OrderPool pool;
+
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < live; ++i)
+        {
+            orders[i] = pool.createLimitOrder(static_cast<unsigned int>(i), instrument, BASE_PRICE, ORDER_QUANTITY, true);
+        }
+        benchmark::DoNotOptimize(orders.data());
+        for (Order *order : orders)
+        {
+            pool.release(order);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.counters["chunks"] = static_cast<double>(pool.getStats().chunkCount);
+}
+BENCHMARK(BM_PooledOrderChurn)->RangeMultiplier(8)->Range(1, 32768);
@@ -0,0 +1,25 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "benchmark_config.hpp"
+#include "InstrumentRegistry.hpp"
+#include "ProtocolParser.h"
+
+// Decode one client message of each type into a Message through parseTCP, as the gateway does for every read
+static void BM_ParseTCP(benchmark::State &state, const std::string &rawData)
+{
+    InstrumentRegistry::getInstance().registerInstrument(BENCHMARK_Config::OrderBook::INSTRUMENT);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(ProtocolParser::parse(rawData, "TCP"));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<long long>(rawData.size()));
+}
+BENCHMARK_CAPTURE(BM_ParseTCP, add_limit,
+    std::string(R"({"type": "ADD_ORDER", "instrument": "BENCH", "price": 100.25, "quantity": 50, "isBuy": true, "orderType": "LIMIT"})"));
+BENCHMARK_CAPTURE(BM_ParseTCP, add_market,
+    std::string(R"({"type": "ADD_ORDER", "instrument": "BENCH", "price": 0, "quantity": 50, "isBuy": false, "orderType": "MARKET"})"));
+BENCHMARK_CAPTURE(BM_ParseTCP, modify,
+    std::string(R"({"type": "MODIFY_ORDER", "orderId": 12345, "instrument": "BENCH", "newPrice": 101.5, "newQuantity": 20})"));
+BENCHMARK_CAPTURE(BM_ParseTCP, cancel,
+    std::string(R"({"type": "CANCEL_ORDER", "orderId": 12345, "instrument": "BENCH"})"));
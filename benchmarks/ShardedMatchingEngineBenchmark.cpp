@@ -0,0 +1,46 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include "benchmark_config.hpp"
+#include "ShardedMatchingEngine.h"
+
+using namespace BENCHMARK_Config::Sharding;
+
+// Bursts of crossing order pairs spread round-robin over INSTRUMENT_COUNT symbols, routed from one producer to
+// range(0) matching threads. Items per second against the thread count is the scaling curve.
+static void BM_ShardedThroughput(benchmark::State &state)
+{
+    ShardedMatchingEngine engine(static_cast<std::size_t>(state.range(0)));
+    std::vector<InstrumentId> instruments;
+    for (int i = 0; i < INSTRUMENT_COUNT; ++i)
+    {
+        const std::string symbol = INSTRUMENT_PREFIX + std::to_string(i);
+        engine.createNewOrderBook(symbol);
+        instruments.push_back(InstrumentRegistry::getInstance().resolve(symbol));
+    }
+    MessageRouter router = engine.getRouter();
+    engine.start();
+
+    const Price price = BENCHMARK_Config::OrderBook::BASE_PRICE;
+    const int quantity = BENCHMARK_Config::OrderBook::ORDER_QUANTITY;
+    std::uint64_t routed = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < BURST_SIZE; i += 2)
+        {
+            // The bid fills the ask right away, books stay empty from burst to burst
+            const InstrumentId instrument = instruments[(i / 2) % INSTRUMENT_COUNT];
+            router.route(Message::createAddOrderMessage(instrument, price, quantity, false, OrderType::LIMIT));
+            router.route(Message::createAddOrderMessage(instrument, price, quantity, true, OrderType::LIMIT));
+        }
+        routed += BURST_SIZE;
+        while (engine.getProcessedCount() < routed)
+        {
+            std::this_thread::yield();
+        }
+    }
+    engine.stop();
+    state.SetItemsProcessed(static_cast<std::int64_t>(routed));
+}
+BENCHMARK(BM_ShardedThroughput)->RangeMultiplier(2)->Range(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
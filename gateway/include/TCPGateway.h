@@ -3,12 +3,27 @@
 
 #include "Gateway.h"
 #include "MessageQueue.h"
+#include "MessageRouter.hpp"
 #include "Logger.hpp"
+#include "TimestampUtility.h"
 #include <uv.h>
+#include <vector>
 
 class TCPGateway : public Gateway {
 public:
+    // Data structure for the data to be sent.
+    struct OutgoingMessage {
+        unsigned int client_id;
+        std::string data;
+        // monotonicNow() readings of the request's arrival and of the ack's creation, 0 if not tracked
+        Timestamp receivedTicks = 0;
+        Timestamp processedTicks = 0;
+        std::uint32_t traceId = 0; // OrderTracer ID of the request, 0 if it is not traced
+    };
+
     explicit TCPGateway(uv_loop_t* loop, MessageQueue& messageQueue);
+    // Sharded setup: every message goes to the queue of the shard owning its instrument
+    TCPGateway(uv_loop_t* loop, MessageRouter router);
     ~TCPGateway() override;
 
     void start(const std::string& ip, int port) override;
@@ -16,6 +31,8 @@ public:
     void receive(const std::string& data, unsigned int client_id) override;
     void send(const std::string& data) override;
     void queueMessageToSend(unsigned int client_id, const std::string& data);
+    // Hands a whole batch to the event loop with one lock and one wake-up, messages is left empty
+    void queueMessagesToSend(std::vector<OutgoingMessage>& messages);
 
 private:
     //
@@ -25,12 +42,6 @@ private:
         unsigned int client_id;
     };
 
-    // Data structure for the data to be sent.
-    struct OutgoingMessage {
-        unsigned int client_id;
-        std::string data;
-    };
-
     static void onAllocBuffer(uv_handle_t* handle, size_t suggested_size, uv_buf_t* buf);
     static void onAsyncCallback(uv_async_t* handle);
     static void onRead(uv_stream_t* client, ssize_t bytesRead, const uv_buf_t* buf);
@@ -38,7 +49,7 @@ private:
     static void onClientClosed(uv_handle_t *handle);
 
     uv_loop_t* loop_;
-    MessageQueue& messageQueue_;
+    MessageRouter router_;
     uv_tcp_t* server_;
     sockaddr_in addr_{};
     std::shared_ptr<spdlog::logger> logger_;
@@ -1,7 +1,10 @@
 #include "ProtocolParser.h"
 #include <stdexcept>
 #include <iostream>
+#include <unordered_map>
 #include <rapidjson/document.h>
+#include "InstrumentRegistry.hpp"
+#include "TickSize.hpp"
 
 using namespace rapidjson;
 
@@ -52,8 +55,9 @@ auto ProtocolParser::parseTCP(const std::string& rawData) -> Message
             throw std::invalid_argument("Missing required fields for ADD_ORDER in TCP data");
         }
 
-        std::string instrument = document["instrument"].GetString();
-        double price = document["price"].GetDouble();
+        // The symbol is resolved here once, the rest of the system only sees the InstrumentId
+        const InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+        const InstrumentId instrument = registry.resolve(document["instrument"].GetString());
         int quantity = document["quantity"].GetInt();
         bool isBuy = document["isBuy"].GetBool();
         std::string orderTypeStr = document["orderType"].GetString();
@@ -69,6 +73,12 @@ auto ProtocolParser::parseTCP(const std::string& rawData) -> Message
             throw std::invalid_argument("Unsupported order type: " + orderTypeStr);
         }
 
+        // Decimal prices are converted onto the instrument's tick grid here; market orders carry no price
+        Price price = -1;
+        if (iter->second != OrderType::MARKET) {
+            price = registry.toTicks(instrument, document["price"].GetDouble());
+        }
+
         return Message::createAddOrderMessage(instrument, price, quantity, isBuy, iter->second);
     }
     if (typeStr == "MODIFY_ORDER") {
@@ -80,8 +90,9 @@ auto ProtocolParser::parseTCP(const std::string& rawData) -> Message
         }
 
         unsigned int orderId = document["orderId"].GetUint();
-        std::string instrument = document["instrument"].GetString();
-        double newPrice = document["newPrice"].GetDouble();
+        const InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+        const InstrumentId instrument = registry.resolve(document["instrument"].GetString());
+        Price newPrice = registry.toTicks(instrument, document["newPrice"].GetDouble());
         int newQuantity = document["newQuantity"].GetInt();
 
         return Message::createModifyOrderMessage(orderId, instrument, newPrice, newQuantity);
@@ -93,7 +104,7 @@ auto ProtocolParser::parseTCP(const std::string& rawData) -> Message
         }
 
         unsigned int orderId = document["orderId"].GetUint();
-        std::string instrument = document["instrument"].GetString();
+        const InstrumentId instrument = InstrumentRegistry::getInstance().resolve(document["instrument"].GetString());
 
         return Message::createCancelOrderMessage(orderId, instrument);
     }
@@ -1,10 +1,13 @@
 #include <iostream>
+#include <stdexcept>
 #include "TCPGateway.h"
 #include "ProtocolParser.h"
 #include <spdlog/fmt/ostr.h>
 
 #include "IDGenerator.hpp"
+#include "LatencyMonitor.h"
 #include "Logger.hpp"
+#include "OrderTracer.h"
 
 template<>
 struct fmt::formatter<uv_handle_type> {
@@ -41,7 +44,10 @@ struct fmt::formatter<uv_handle_type> {
 };
 
 TCPGateway::TCPGateway(uv_loop_t* loop, MessageQueue& messageQueue)
-    : loop_(loop), messageQueue_(messageQueue), server_(nullptr), logger_(Logger::getLogger("TCPGateway")) {}
+    : TCPGateway(loop, MessageRouter(messageQueue)) {}
+
+TCPGateway::TCPGateway(uv_loop_t* loop, MessageRouter router)
+    : loop_(loop), router_(std::move(router)), server_(nullptr), logger_(Logger::getLogger("TCPGateway")) {}
 
 TCPGateway::~TCPGateway()
 {
@@ -93,6 +99,12 @@ void TCPGateway::onAsyncCallback(uv_async_t *handle) {
                 gateway->logger_->error("uv_write error: {}", uv_strerror(write_ret));
                 delete write_data;
                 delete write_req;
+            } else {
+                const Timestamp writtenTicks = monotonicNow();
+                LatencyMonitor &monitor = LatencyMonitor::getInstance();
+                monitor.record(LatencyStage::ACK, msg.processedTicks, writtenTicks);
+                monitor.record(LatencyStage::END_TO_END, msg.receivedTicks, writtenTicks);
+                OrderTracer::getInstance().record(msg.traceId, TraceStage::ACK_WRITTEN);
             }
         } else {
             gateway->logger_->warn("Client ID {} not found. Unable to send message.", msg.client_id);
@@ -243,9 +255,25 @@ void TCPGateway::onRead(uv_stream_t *client, ssize_t bytesRead, const uv_buf_t *
 
 void TCPGateway::receive(const std::string& data, const unsigned int client_id)
 {   
-    Message message = ProtocolParser::parse(data, "TCP");
+    // The only timestamp stored with the order, the engine and the fills reuse this reading
+    const Timestamp receivedAt = monotonicNow();
+    OrderTracer &tracer = OrderTracer::getInstance();
+    const std::uint32_t traceId = tracer.sample();
+    tracer.record(traceId, TraceStage::GATEWAY_READ);
+    Message message;
+    try {
+        message = ProtocolParser::parse(data, "TCP");
+    } catch (const std::invalid_argument& e) {
+        // Runs inside the libuv read callback: a malformed message, an unknown symbol or an off-grid price
+        // rejects that one message instead of escaping the event loop
+        logger_->warn("Rejected message from client {}: {}", client_id, e.what());
+        queueMessageToSend(client_id, std::string("Order rejected: ") + e.what());
+        return;
+    }
     message.client_id = client_id;
-    messageQueue_.push(std::move(message));
+    message.timestamp = receivedAt;
+    message.traceId = traceId;
+    router_.route(std::move(message));
 }
 
 void TCPGateway::send(const std::string &data) {
@@ -307,5 +335,26 @@ void TCPGateway::queueMessageToSend(unsigned int client_id, const std::string &d
         outgoing_queue_.push(std::move(msg));
     }
 
+    // Before start() there is no loop to wake, the message goes out with the first batch after it
+    if (async_handle_.loop != nullptr) {
+        uv_async_send(&async_handle_);
+    }
+}
+
+void TCPGateway::queueMessagesToSend(std::vector<OutgoingMessage> &messages) {
+    if (messages.empty()) {
+        return;
+    }
+
+    {
+        OrderTracer &tracer = OrderTracer::getInstance();
+        std::lock_guard<std::mutex> lock(outgoing_mutex_);
+        for (OutgoingMessage &msg : messages) {
+            tracer.record(msg.traceId, TraceStage::ACK_QUEUED);
+            outgoing_queue_.push(std::move(msg));
+        }
+    }
+    messages.clear();
+
     uv_async_send(&async_handle_);
 }
@@ -0,0 +1,28 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+
+namespace BENCHMARK_Config {
+
+    namespace OrderBook {
+        constexpr auto INSTRUMENT = "BENCH";
+        constexpr long long BASE_PRICE = 1000000; // in ticks
+        constexpr int ORDER_QUANTITY = 10;
+    }
+
+    namespace PriceLevel {
+        // Orders of other levels allocated between two makers of the benchmarked level
+        constexpr std::size_t LEVEL_STRIDE = 8;
+    }
+
+    namespace Sharding {
+        constexpr auto INSTRUMENT_PREFIX = "SHARD";
+        constexpr int INSTRUMENT_COUNT = 64;
+        // Messages routed per iteration before waiting for the shards to catch up
+        constexpr int BURST_SIZE = 4096;
+    }
+
+}
+
+#endif // BENCHMARK_HPP
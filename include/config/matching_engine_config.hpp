@@ -1,19 +1,67 @@
 #ifndef MATCHING_ENGINE_CONFIG_HPP
 #define MATCHING_ENGINE_CONFIG_HPP
 
+#include <cstddef>
+
 namespace matchingSystemConfig {
 
     namespace orderBook {
-
+        // Ticks covered by the array part of each side's price ladder, prices outside go to the overflow map
+        constexpr std::size_t PRICE_LADDER_WINDOW = 4096;
+        // Ticks kept free on the better side of the best price when the ladder is re-anchored
+        constexpr std::size_t PRICE_LADDER_HEADROOM = 512;
+        // Price levels per slab chunk of each book's level pool, one chunk is allocated up front
+        constexpr std::size_t PRICE_LEVEL_CHUNK_SIZE = 1024;
+        // Entries reserved by a LevelQueue when it is created
+        constexpr std::size_t LEVEL_QUEUE_CAPACITY = 16;
+        // Dead entries (consumed or cancelled) a LevelQueue holds before compaction is worth it
+        constexpr std::size_t LEVEL_QUEUE_MIN_COMPACTION = 64;
+        // Resting orders each book's order ID index is sized for up front (16 bytes per slot, two slots per order).
+        // A book that holds more doubles its index, rehashing it once on the matching thread
+        constexpr std::size_t EXPECTED_RESTING_ORDERS = 8192;
     }
 
     namespace orderManager {
         constexpr auto LOGGER_NAME = "orderManager";
+        // Messages taken off the queue per processing round, 1 handles them one at a time
+        constexpr std::size_t BATCH_SIZE = 64;
     }
 
     namespace mathingEngine {
         constexpr auto LOGGER_NAME = "matchingEngine";
+        // Bytes per slab chunk of the engine's order pool, a power of two holding about 9300 orders
+        constexpr std::size_t ORDER_POOL_CHUNK_BYTES = std::size_t{1} << 19;
+        // Most recent order IDs remembered exactly for duplicate detection (a 256 KiB bitmap)
+        constexpr std::size_t ORDER_ID_WINDOW = std::size_t{1} << 21;
+
+    }
+
+    namespace eventLog {
+        // Records each matching thread can have waiting for the formatter before new ones are dropped
+        constexpr std::size_t RING_CAPACITY = std::size_t{1} << 14;
+        // Sleep of the formatter thread after a drain that found nothing
+        constexpr unsigned int IDLE_SLEEP_US = 1000;
+        // Line format of the order and trade logs, "default" or "json"
+        constexpr auto FORMAT = "default";
+    }
+
+    namespace tradeHistory {
+        // Recent trades every engine keeps in memory
+        constexpr std::size_t RECENT_CAPACITY = 65536;
+        // Shard i of the launcher appends its full trade history to <prefix>_shard<i>.bin
+        constexpr auto LOG_FILE_PREFIX = "trades";
+    }
+
+    namespace journal {
+        // Shard i of the launcher journals its input messages to <prefix>_shard<i>.journal
+        constexpr auto FILE_PREFIX = "journal";
+        // When journal records reach the disk, "none", "periodic" or "group_commit"
+        constexpr auto SYNC_POLICY = "periodic";
+    }
 
+    namespace shardedEngine {
+        // Matching threads, each owning the books of the instruments with id % SHARD_COUNT equal to its index
+        constexpr std::size_t SHARD_COUNT = 4;
     }
 
 }
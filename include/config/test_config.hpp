@@ -6,7 +6,7 @@ namespace TEST_Config {
     namespace OrderManager {
         constexpr auto INSTRUMENT = "AAPL";
         constexpr unsigned int PORT = 7001;
-        constexpr float PRICE = 160.0;
+        constexpr int PRICE = 160; // in ticks
     }
 
     namespace Integration {
@@ -1,15 +1,72 @@
 #ifndef UTILITY_CONFIG_HPP
 #define UTILITY_CONFIG_HPP
 
+#include <cstddef>
+#include <cstdint>
+
 namespace Utility_Config {
     constexpr int DEFAULT_TIMEOUT_MS = 5000;
     constexpr int MAX_RETRIES = 3;
 
+    namespace Tick {
+        constexpr double DEFAULT_TICK_SIZE = 0.01;
+        // Relative error accepted when converting a decimal price onto the tick grid
+        constexpr double TICK_TOLERANCE = 1e-6;
+    }
+
+    namespace Instrument {
+        // Capacity of the InstrumentRegistry, InstrumentIds are taken from [0, MAX_INSTRUMENTS)
+        constexpr std::size_t MAX_INSTRUMENTS = 1024;
+    }
+
+    namespace MessageQueue {
+        // Slots of the gateway -> OrderManager ring buffer, rounded up to a power of two
+        constexpr std::size_t DEFAULT_CAPACITY = 65536;
+        // Empty polls before a spin-then-yield or spin-then-park consumer stops spinning
+        constexpr int SPIN_LIMIT = 2048;
+    }
+
     namespace Trade {
         constexpr int DEFAULT_ALIGNMENT_DISPLAY = 20;
         constexpr int DEFAULT_PRECISION_DISPLAY = 2;
     }
 
+    namespace Mapping {
+        // Address space a MappedFile reserves so it can grow in place, the most a trade log or journal can reach
+        constexpr std::size_t RESERVED_BYTES = std::size_t{1} << 35;
+    }
+
+    namespace TradeLog {
+        // Records the trade log file is sized for when created, it doubles whenever it fills up
+        constexpr std::size_t INITIAL_CAPACITY = 1 << 20;
+    }
+
+    namespace Clock {
+        // Busy wait the TSC rate is measured over against the steady clock, once per process
+        constexpr int CALIBRATION_MS = 10;
+    }
+
+    namespace Journal {
+        // Records an input journal file is preallocated for when created, it doubles whenever it fills up
+        constexpr std::size_t INITIAL_CAPACITY = 1 << 18;
+        // Time between two msyncs of the periodic sync policy
+        constexpr int SYNC_INTERVAL_MS = 10;
+        // How often the group commit syncer looks for a newly committed batch
+        constexpr int GROUP_COMMIT_POLL_US = 50;
+    }
+
+    namespace Latency {
+        // Linear sub-buckets per power of two in a latency histogram, 2^5 keeps every bucket within about 3%
+        constexpr unsigned int SUB_BUCKET_BITS = 5;
+    }
+
+    namespace Tracing {
+        // Events each thread keeps for the order tracer before overwriting the oldest, a power of two
+        constexpr std::size_t BUFFER_EVENTS = 1 << 16;
+        // One inbound message in this many is traced, 0 leaves tracing off until it is configured
+        constexpr std::uint32_t DEFAULT_SAMPLE_INTERVAL = 0;
+    }
+
     namespace Logging {
         constexpr int LOG_QUEUE_SIZE = 8192;
         constexpr int LOG_THREADS = 1;
@@ -0,0 +1,111 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InstrumentRegistry.hpp"
+#include "Message.hpp"
+#include "OrderType.h"
+#include "TickSize.hpp"
+#include "Trade.h"
+#include "matching_engine_config.hpp"
+
+enum class EventType : std::uint8_t
+{
+    ADD_ORDER,
+    MODIFY_ORDER,
+    CANCEL_ORDER,
+    TRADE
+};
+
+// Everything a log line of an order message or a trade is made of, as plain integers
+struct alignas(64) EventRecord
+{
+    std::int64_t timestampNs;   // Trades only: wall time since the system_clock epoch, as the Trade keeps it
+    Price price;
+    std::uint32_t id;           // Order ID of a modify or cancel, trade ID of a trade
+    std::uint32_t buyOrderId;   // Trades only
+    std::uint32_t sellOrderId;  // Trades only
+    std::int32_t quantity;
+    std::int32_t buyLeavesQuantity;
+    std::int32_t sellLeavesQuantity;
+    InstrumentId instrument;
+    EventType type;
+    OrderType orderType;
+    bool isBuy;
+    TradeStatus buyStatus;
+    TradeStatus sellStatus;
+};
+
+static_assert(sizeof(EventRecord) == 64, "EventRecord must fill exactly one cache line");
+
+// Deferred-formatting log of the matching threads.
+// The matching thread copies a fixed-size EventRecord into a ring of its own (registered on first use) and
+// moves on; a background thread drains every ring and turns the records into text or JSON lines, one logger
+// call per drain, so no string is built or formatted on the matching path. A full ring drops the record
+// and counts it rather than stall matching; the next drain logs a warning with the number dropped.
+// start/stop are counted: the formatter runs while at least one OrderManager runs, and stop drains the
+// rings before returning.
+class EventLog
+{
+public:
+    static constexpr std::size_t RING_CAPACITY = matchingSystemConfig::eventLog::RING_CAPACITY;
+    static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "The event ring capacity must be a power of two");
+
+    static auto getInstance() -> EventLog &;
+
+    EventLog(const EventLog &) = delete;
+    auto operator=(const EventLog &) -> EventLog & = delete;
+
+    void start();
+    void stop();
+
+    void logMessage(const Message &message);
+    void logTrade(const Trade &trade);
+
+    // Formats and logs whatever the rings hold and warns of new drops, returns the number of records written
+    auto drain() -> std::size_t;
+    // Records lost to a full ring so far
+    [[nodiscard]] auto droppedCount() const -> std::uint64_t;
+
+    static auto fromMessage(const Message &message) -> EventRecord;
+    static auto fromTrade(const Trade &trade) -> EventRecord;
+    // Same line as the toString of the message details or formatTrade gives, format is "default", "json" or "csv"
+    static auto format(const EventRecord &record, const std::string &format) -> std::string;
+
+private:
+    // Single producer, single consumer
+    struct Ring
+    {
+        EventRecord records[RING_CAPACITY];
+        alignas(64) std::atomic<std::uint64_t> head{0};  // Written by the matching thread
+        alignas(64) std::atomic<std::uint64_t> tail{0};  // Written by the draining thread
+        std::atomic<std::uint64_t> dropped{0};
+    };
+
+    EventLog() = default;
+
+    void push(const EventRecord &record);
+    auto localRing() -> Ring &;
+    void formatLoop();
+
+    static thread_local Ring *local;
+
+    // Guards the ring list and serialises draining
+    mutable std::mutex ringsMutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    std::uint64_t reportedDropped = 0;  // Drops already warned about by a drain
+
+    std::mutex lifecycleMutex;
+    std::size_t users = 0;
+    std::atomic<bool> running{false};
+    std::thread formatter;
+};
+
+#endif // EVENT_LOG_H
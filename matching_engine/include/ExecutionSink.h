@@ -0,0 +1,39 @@
+#ifndef EXECUTION_SINK_H
+#define EXECUTION_SINK_H
+
+#include <vector>
+#include "Trade.h"
+
+// Receives fills from the matching loop as they happen, before matchOrder moves on to the next maker.
+// Implementations run on the matching thread and must not call back into the engine.
+class ExecutionSink
+{
+public:
+    virtual ~ExecutionSink() = default;
+
+    virtual void onTrade(const Trade &trade) = 0;
+};
+
+// Default sink: the engine still records every trade into its TradeHistory, the OrderManager logs them from there
+class NullExecutionSink final : public ExecutionSink
+{
+public:
+    void onTrade(const Trade &/*trade*/) override {}
+};
+
+// Collects fills into a caller-owned vector, for callers that want the old return-by-value behaviour
+class TradeCollector final : public ExecutionSink
+{
+public:
+    explicit TradeCollector(std::vector<Trade> &trades) : trades(trades) {}
+
+    void onTrade(const Trade &trade) override
+    {
+        trades.push_back(trade);
+    }
+
+private:
+    std::vector<Trade> &trades;
+};
+
+#endif // EXECUTION_SINK_H
@@ -0,0 +1,117 @@
+#ifndef LEVEL_QUEUE_H
+#define LEVEL_QUEUE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Order.h"
+#include "matching_engine_config.hpp"
+
+// Time-priority queue of the makers resting at one price, as an alternative to the intrusive Order list.
+// The fields matching needs (order ID, open quantity, owning Order) sit next to each other in one array,
+// so sweeping a level reads consecutive 16-byte entries instead of chasing a pointer per maker.
+// A cancel leaves a tombstone (zero quantity) in place; tombstones at the front are skipped by matching,
+// the ones in the middle are squeezed out by compact() once they outnumber the live entries.
+// A Position stays valid until the next compact(), which reports every entry it moves.
+class LevelQueue
+{
+public:
+    struct Entry
+    {
+        unsigned int orderId;
+        int quantity;  // Open quantity, zero for a tombstone
+        Order *order;
+    };
+
+    using Position = std::uint32_t;
+
+    explicit LevelQueue(std::size_t initialCapacity = matchingSystemConfig::orderBook::LEVEL_QUEUE_CAPACITY);
+
+    // Append a maker at the back of the queue
+    auto push(unsigned int orderId, int quantity, Order *order) -> Position;
+
+    // Tombstone the entry at position, throws if it is not a live entry
+    void cancel(Position position);
+
+    // Lower the open quantity of a live entry in place, keeping its time priority; zero cancels it.
+    // Throws std::invalid_argument for an increase, which must lose priority: cancel and push it again
+    void reduce(Position position, int newQuantity);
+
+    [[nodiscard]] auto at(Position position) const -> const Entry &;
+
+    // Oldest live entry, nullptr if the level is empty
+    [[nodiscard]] auto front() -> const Entry *;
+
+    // Fill up to quantity from the front in time priority and return the quantity filled.
+    // onFill(entry, traded) is called per maker after its quantity was reduced, so entry.quantity is its leaves.
+    template <typename OnFill>
+    auto match(int quantity, OnFill &&onFill) -> int
+    {
+        int filled = 0;
+        while (quantity > 0 && head < entries.size())
+        {
+            Entry &entry = entries[head];
+            if (entry.quantity == 0)
+            {
+                --tombstones;
+                ++head;
+                continue;
+            }
+            const int traded = std::min(entry.quantity, quantity);
+            entry.quantity -= traded;
+            totalQuantity -= traded;
+            quantity -= traded;
+            filled += traded;
+            onFill(static_cast<const Entry &>(entry), traded);
+            if (entry.quantity == 0)
+            {
+                --live;
+                ++head;
+            }
+        }
+        recycleIfEmpty();
+        return filled;
+    }
+
+    // Whether enough tombstones piled up for compact() to pay off
+    [[nodiscard]] auto needsCompaction() const -> bool;
+
+    // Move the live entries to the front of the storage, dropping consumed entries and tombstones.
+    // onMove(entry, newPosition) is called for every live entry, in time priority.
+    template <typename OnMove>
+    void compact(OnMove &&onMove)
+    {
+        std::size_t target = 0;
+        for (std::size_t i = head; i < entries.size(); ++i)
+        {
+            if (entries[i].quantity == 0)
+            {
+                continue;
+            }
+            entries[target] = entries[i];
+            onMove(static_cast<const Entry &>(entries[target]), static_cast<Position>(target));
+            ++target;
+        }
+        entries.resize(target);
+        head = 0;
+        tombstones = 0;
+    }
+
+    [[nodiscard]] auto getTotalQuantity() const -> int;
+    [[nodiscard]] auto liveCount() const -> std::size_t;
+    [[nodiscard]] auto tombstoneCount() const -> std::size_t;
+    [[nodiscard]] auto empty() const -> bool;
+
+private:
+    std::vector<Entry> entries;  // [head, size) is the queue, older slots are consumed
+    std::size_t head = 0;
+    std::size_t live = 0;
+    std::size_t tombstones = 0;  // Cancelled entries at or after head
+    int totalQuantity = 0;
+
+    [[nodiscard]] auto liveEntry(Position position) -> Entry &;
+    void recycleIfEmpty();
+};
+
+#endif // LEVEL_QUEUE_H
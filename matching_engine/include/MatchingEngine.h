@@ -1,19 +1,32 @@
 #ifndef MATCHING_ENGINE_H
 #define MATCHING_ENGINE_H
 
-#include <shared_mutex>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
+#include "ExecutionSink.h"
+#include "IDGenerator.hpp"
+#include "InstrumentRegistry.hpp"
 #include "Order.h"
 #include "Trade.h"
+#include "TradeHistory.h"
 #include "OrderBook.h"
+#include "OrderIdTracker.h"
+#include "OrderPool.h"
+#include "TickSize.hpp"
+#include "matching_engine_config.hpp"
+#include "utility_config.hpp"
 
 class MatchingEngine
 {
 public:
     MatchingEngine();
+    // Also appends every trade to the memory-mapped trade log at tradeLogPath. Shard shardIndex of 2^shardBits
+    // takes its order and trade IDs from its own ShardIDGenerator
+    explicit MatchingEngine(const std::string &tradeLogPath, unsigned int shardIndex = 0, unsigned int shardBits = 0);
     ~MatchingEngine();
 
     MatchingEngine(const MatchingEngine&) = delete;
@@ -23,46 +36,80 @@ public:
     auto operator=(const MatchingEngine&&) -> MatchingEngine& = delete;
 
     // Add a new Instrument or Remove an existing Instrument
-    auto createNewOrderBook(const std::string &instrument) -> bool;
-    void removeOrderBook(const std::string &instrument);
-
+    // The symbol is registered in the InstrumentRegistry, every other call takes its InstrumentId.
+    // expectedOrders sizes the book's order ID index, a busy book given too few pays a rehash when it outgrows it
+    auto createNewOrderBook(const std::string &instrument,
+                            double tickSize = Utility_Config::Tick::DEFAULT_TICK_SIZE,
+                            std::size_t expectedOrders = matchingSystemConfig::orderBook::EXPECTED_RESTING_ORDERS) -> bool;
+    void removeOrderBook(InstrumentId instrument);
+
+    // Orders passed to processNewOrder must come from this pool, the engine releases them once they leave the book
+    auto getOrderPool() -> OrderPool &;
+
+    // Matches the order and reports each fill to sink as it happens, without building a trade list
+    void processNewOrder(Order *order, ExecutionSink &sink);
+    // Compatibility wrapper collecting the fills of this order into a vector
     auto processNewOrder(Order *order) -> std::vector<Trade>;
 
-    void cancelOrder(unsigned int orderId, const std::string &instrument);
+    // Sink for fills of orders the engine re-enters itself (a modify crossing the spread), and for callers
+    // without one of their own. Defaults to a NullExecutionSink; the sink must outlive the engine's use of it
+    void setExecutionSink(ExecutionSink *sink);
+    auto getExecutionSink() -> ExecutionSink &;
+
+    void cancelOrder(unsigned int orderId, InstrumentId instrument);
 
-    void modifyOrder(unsigned int orderId, const std::string &instrument, double newPrice, int newQuantity);
+    void modifyOrder(unsigned int orderId, InstrumentId instrument, Price newPrice, int newQuantity);
 
+    // Copy of the recent trades kept in memory, oldest first
     [[nodiscard]] auto getTrades() -> std::vector<Trade>;
+    [[nodiscard]] auto getTradeHistory() const -> const TradeHistory &;
 
-    auto getLastTradePrice(const std::string &instrument) -> double;
+    auto getLastTradePrice(InstrumentId instrument) -> Price;
 
-    [[nodiscard]] auto getOrderBookForRead(const std::string &instrument) -> const OrderBook*;
+    [[nodiscard]] auto getOrderBookForRead(InstrumentId instrument) -> const OrderBook*;
 
-    auto hasOrder(const std::string& instrument, unsigned int orderId) -> bool;
+    auto hasOrder(InstrumentId instrument, unsigned int orderId) -> bool;
 
-    auto hasInstrument(const std::string& instrument) -> bool;
+    auto hasInstrument(InstrumentId instrument) -> bool;
 
     auto hasOrderId(unsigned int orderId) -> bool;
 
+    // IDs of this engine's orders and trades, for its matching thread only
+    auto getIDGenerator() -> ShardIDGenerator &;
+
 private:
 
-    std::shared_mutex orderBooksMutex;
+    // Declared first so it outlives the books holding its orders
+    OrderPool orderPool;
 
-    std::unordered_set<unsigned int> globalOrderIds;
+    // Book directory indexed by InstrumentId. Lookups are plain acquire loads; createNewOrderBook and
+    // removeOrderBook publish changes under orderBooksWriteMutex, which lookups never take.
+    std::array<std::atomic<OrderBook *>, InstrumentRegistry::MAX_INSTRUMENTS> orderBooks;
+    std::mutex orderBooksWriteMutex;
+    // Removed books stay allocated until the engine is destroyed, a reader may still hold one
+    std::vector<std::unique_ptr<OrderBook>> retiredOrderBooks;
 
-    std::unordered_map<std::string, OrderBook *> orderBooks;
+    ShardIDGenerator idGenerator;
 
-    std::unordered_map<std::string, double> instrumentToTradedPrice;
+    // Every order ID the engine has processed, kept in bounded memory
+    OrderIdTracker seenOrderIds;
+
+    std::vector<Price> instrumentToTradedPrice;
     
-    std::vector<Trade> trades;
+    TradeHistory tradeHistory;
+
+    NullExecutionSink nullSink;
+    ExecutionSink *executionSink = &nullSink;
 
-    auto processLimitOrder(Order *order) -> std::vector<Trade>;
-    auto processMarketOrder(Order *order) -> std::vector<Trade>;
-    auto processStopOrder(Order *order) -> std::vector<Trade>;
+    void processLimitOrder(Order *order, ExecutionSink &sink);
+    void processMarketOrder(Order *order, ExecutionSink &sink);
+    void processStopOrder(Order *order, ExecutionSink &sink);
 
-    auto matchOrder(Order *order) -> std::vector<Trade>;
+    void matchOrder(Order *order, ExecutionSink &sink);
+    // Records, logs and forwards one fill
+    void emitTrade(const Trade &trade, ExecutionSink &sink);
 
-    auto getOrderBook(const std::string &instrument) -> OrderBook *;
+    auto getOrderBook(InstrumentId instrument) -> OrderBook *;
 
 };
 
@@ -0,0 +1,42 @@
+#ifndef OCCUPANCY_BITMAP_H
+#define OCCUPANCY_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Three-level occupancy bitmap over slot indices.
+// Each bit of a summary word tells whether the 64-bit word below it has any bit set, so finding the
+// next or previous occupied slot from any index is at most three ctz/clz operations per direction.
+// Capacity is 64 * 64 * 64 = 262144 slots.
+class OccupancyBitmap
+{
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+    static constexpr std::size_t MAX_SIZE = 64 * 64 * 64;
+
+    explicit OccupancyBitmap(std::size_t size);
+
+    void set(std::size_t index);
+    void clear(std::size_t index);
+    [[nodiscard]] bool test(std::size_t index) const;
+    [[nodiscard]] bool any() const;
+
+    // Lowest set index >= from, npos if none
+    [[nodiscard]] std::size_t findNext(std::size_t from) const;
+    // Highest set index <= from, npos if none
+    [[nodiscard]] std::size_t findPrev(std::size_t from) const;
+
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    std::size_t bitCount;
+    std::uint64_t top = 0;              // One bit per mid word
+    std::vector<std::uint64_t> mid;     // One bit per leaf word
+    std::vector<std::uint64_t> leaves;  // One bit per slot
+
+    [[nodiscard]] std::size_t lowestIn(std::size_t midIndex) const;
+    [[nodiscard]] std::size_t highestIn(std::size_t midIndex) const;
+};
+
+#endif // OCCUPANCY_BITMAP_H
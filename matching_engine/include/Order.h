@@ -1,42 +1,68 @@
 #ifndef ORDER_H
 #define ORDER_H
 
-#include <string>
+#include "InstrumentRegistry.hpp"
 #include "OrderType.h"
+#include "SplitSlabPool.hpp"
+#include "TickSize.hpp"
+#include "TimestampUtility.h"
+#include "matching_engine_config.hpp"
 
-class Order {
+// Fields of an order the matching loop never reads, kept in the pool's side table next to the Order slot
+struct OrderDetails
+{
+    Price price = 0;                                 // price in ticks
+    Timestamp timestamp = 0;                         // monotonicNow() reading of the order's arrival
+    InstrumentId instrument = InstrumentRegistry::INVALID_ID;
+};
+
+// The hot part of an order: what sweeping a price level touches, two orders per cache line.
+// Price, instrument and timestamp live in the OrderDetails of the same pool slot, see OrderSlab.
+class alignas(32) Order {
 public:
 
-    void setPrice(double new_price);
+    void setPrice(Price new_price);
     void setQuantity(int new_quantity);
+    // Take an execution off the open quantity, a fully filled order is left with zero
+    void fill(int filled_quantity);
     
-    [[nodiscard]] double getPrice() const;          // Getter for price
+    [[nodiscard]] Price getPrice() const;           // Getter for price, in ticks
     [[nodiscard]] int getQuantity() const;          // Getter for quantity
     [[nodiscard]] unsigned int getId() const;       // Getter for id
-    [[nodiscard]] std::string getAsset() const;
+    [[nodiscard]] InstrumentId getInstrument() const;
     [[nodiscard]] bool isBuy() const;               // Getter for is_buy
     [[nodiscard]] OrderType getType() const;        // Getter for type
-    [[nodiscard]] std::chrono::system_clock::time_point getTimestamp() const; // Getter for timestamp
+    [[nodiscard]] Timestamp getTimestamp() const;   // Getter for timestamp, see toWallClock
 
     void displayOrderInfo() const;
 
     bool operator==(const Order &other) const;
     bool operator<(const Order &other) const;
 
-    static Order *CreateLimitOrder(unsigned int id, const std::string &asset, double price, int quantity, bool is_buy);
-    static Order *CreateMarketOrder(unsigned int id, const std::string &asset, int quantity, bool is_buy);
-    static Order *CreateStopOrder(unsigned int id, const std::string &asset, double price, int quantity, bool is_buy);
+    // Orders are only created through the OrderPool and linked into their price level by the OrderBook
+    friend class OrderPool;
+    friend class SplitSlabPool<Order, OrderDetails, matchingSystemConfig::mathingEngine::ORDER_POOL_CHUNK_BYTES>;
+    friend class OrderBook;
+    friend class MatchingEngine;
 
 private:
     unsigned int id;  // order ID
-    std::string asset; // asset name
-    double price;      // price
     int quantity;      // quantity
     bool is_buy;       // whether it is a buy order
     OrderType type;    // order type
-    std::chrono::system_clock::time_point timestamp; // timestamp
 
-    Order(unsigned int id, std::string asset, double price, int quantity, bool is_buy, OrderType type);
+    Order *prev = nullptr; // The previous order at the same price level
+    Order *next = nullptr; // The next order at the same price level
+
+    // Only valid inside an OrderSlab slot, the constructor writes the cold fields to the slot's details
+    Order(unsigned int id, InstrumentId instrument, Price price, int quantity, bool is_buy, OrderType type, Timestamp timestamp);
+
+    [[nodiscard]] auto details() -> OrderDetails &;
+    [[nodiscard]] auto details() const -> const OrderDetails &;
 };
 
+static_assert(sizeof(Order) == 32, "The hot order record must stay at half a cache line");
+
+using OrderSlab = SplitSlabPool<Order, OrderDetails, matchingSystemConfig::mathingEngine::ORDER_POOL_CHUNK_BYTES>;
+
 #endif // ORDER_H
@@ -1,11 +1,16 @@
 #ifndef ORDER_BOOK_H
 #define ORDER_BOOK_H
 
-#include <string>
-#include <unordered_map>
+#include <functional>
 #include <map>
-#include <stack>
+#include "InstrumentRegistry.hpp"
 #include "Order.h"
+#include "OrderIdIndex.h"
+#include "OrderPool.h"
+#include "PriceLadder.h"
+#include "SlabPool.hpp"
+#include "TickSize.hpp"
+#include "matching_engine_config.hpp"
 
 enum class Side
 {
@@ -17,8 +22,10 @@ enum class Side
 class OrderBook
 {
 public:
-    // Constructor
-    explicit OrderBook(std::string instrument);
+    // Constructor, orders resting in the book are created in and released to orderPool.
+    // The order ID index is sized for expectedOrders resting at once
+    OrderBook(InstrumentId instrument, double tickSize, OrderPool &orderPool,
+              std::size_t expectedOrders = matchingSystemConfig::orderBook::EXPECTED_RESTING_ORDERS);
 
     using CrossCallback = std::function<void(Order*)>;
 
@@ -36,18 +43,23 @@ public:
     void cancelStopOrder(unsigned int orderId);
 
     // Modify Orders
-    void modifyLimitOrder(unsigned int orderId, double newPrice, int newQuantity);
-    void modifyStopOrder(unsigned int orderId, double newPrice, int newQuantity);
+    void modifyLimitOrder(unsigned int orderId, Price newPrice, int newQuantity);
+    void modifyStopOrder(unsigned int orderId, Price newPrice, int newQuantity);
 
     // Get the BBA
     [[nodiscard]] Order *getBestBid() const;
     [[nodiscard]] Order *getBestAsk() const;
 
+    [[nodiscard]] double getTickSize() const;
+
+    // Allocation counters and memory footprint of the price level pool
+    [[nodiscard]] const SlabPoolStats &getPriceLevelStats() const;
+
     // Print the OrderBook - Print all the price layers
     void printOrderBook() const;
 
-    // Print the OrderBook with designated price range
-    void printOrderBook(double minPrice, double maxPrice) const;
+    // Print the OrderBook with designated price range, in ticks
+    void printOrderBook(Price minPrice, Price maxPrice) const;
 
     // Print the OrderBook with designated top N levels
     void printOrderBook(int depth) const;
@@ -55,61 +67,50 @@ public:
     friend class MatchingEngine;
 
 private:
-    // Node for each order at the same price level
-    struct OrderNode
-    {
-        Order *order = nullptr;
-        OrderNode *prev = nullptr; // The previous order at the same price level
-        OrderNode *next = nullptr; // The next order at the same price level
-    };
-
     // Node for Price Level, it contains all the orders and total amount for the price
     struct PriceLevel
     {
-        double price = -1;
+        Price price = -1;
         int totalQuantity = -1;
         Side side = Side::UNDEFINED;
-        OrderNode *headOrder = nullptr;  // Link List Header
-        OrderNode *tailOrder = nullptr;  // Link List Tail
-        PriceLevel *prevPrice = nullptr; // Previous Price level
-        PriceLevel *nextPrice = nullptr; // Next Price Level
+        Order *headOrder = nullptr;  // Link List Header
+        Order *tailOrder = nullptr;  // Link List Tail
     };
 
-    std::string instrument;
+    InstrumentId instrument;
+    double tickSize;
     CrossCallback crossCallback;
+    OrderPool &orderPool;
 
     // BBO
     PriceLevel *bestBidLevel;
     PriceLevel *bestAskLevel;
 
-    // Mapping from price to price level, for quick access
-    std::unordered_map<double, PriceLevel *> priceToPriceLevel;
-    std::map<double, OrderNode *> priceToStopOrder;
+    // Price levels of each side indexed by tick, for quick access and best price discovery
+    PriceLadder<PriceLevel> bidLadder;
+    PriceLadder<PriceLevel> askLadder;
+    std::map<Price, Order *> priceToStopOrder;
+
+    // Mapping from order ID to the resting Order, for quick cancellation and order modification
+    OrderIdIndex orderIdToOrder;
 
-    // Mapping from order ID to the Order node, for quick cancellation and order modification
-    std::unordered_map<unsigned int, OrderNode *> orderIdToOrderNode;
+    // Slab pool backing every PriceLevel of this book
+    SlabPool<PriceLevel> priceLevelPool;
 
-    // Improve memory management and efficiency
-    std::stack<OrderNode *> emptyOrderNodeStack;
-    std::stack<PriceLevel *> emptyPriceLevelStack;
-    
     void addPriceLevel(PriceLevel *priceLevel, PriceLevel *&bestLevel);
     void addLimitOrderToBook(Order *order);
     void addStopOrderToBook(Order *order);
-    void removeOrderNodeFromBook(OrderNode *orderNode);
+    void removeOrderFromBook(Order *order);
     void removePriceFromBook(PriceLevel *priceLevel);
     void updateBestPrices();
 
-    // Get an empty node from the emptyOrderNodeStack
-    OrderNode *getOrderNode();
-    void releaseOrderNode(OrderNode *node);
-    // Get an empty PriceLevel from the emptyPriceLevelStack
+    PriceLadder<PriceLevel> &getLadder(Side side);
+    [[nodiscard]] const PriceLadder<PriceLevel> &getLadder(Side side) const;
+
+    // Get an empty PriceLevel from the priceLevelPool
     PriceLevel *getPriceLevel();
     void releasePriceLevel(PriceLevel *level);
 
-    // clear and optimize memory layout
-    void cleanup();
-
     // assistant function to print a specific price level
     void printPriceLevel(const PriceLevel *start, int depth) const;
 };
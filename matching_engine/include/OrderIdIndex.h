@@ -0,0 +1,59 @@
+#ifndef ORDER_ID_INDEX_H
+#define ORDER_ID_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "matching_engine_config.hpp"
+
+class Order;
+
+// Order ID -> Order lookup of one book, a flat open-addressing table with linear probing.
+// IDs come from one ShardIDGenerator shared by every book of the engine, so a book only sees a sparse slice of them;
+// the table is therefore sized by the orders resting in the book, never by how far apart their IDs are.
+// A multiplicative hash spreads the monotonic IDs and erase shifts the following entries back instead of leaving
+// tombstones. The table is sized for expectedOrders when it is built and only allocates again when the book holds
+// more than that: it then doubles, rehashing every entry inside that one insert.
+class OrderIdIndex
+{
+public:
+    static constexpr std::size_t MIN_CAPACITY = 16;
+
+    explicit OrderIdIndex(std::size_t expectedOrders = matchingSystemConfig::orderBook::EXPECTED_RESTING_ORDERS);
+
+    OrderIdIndex(const OrderIdIndex&) = delete;
+    auto operator=(const OrderIdIndex&) -> OrderIdIndex& = delete;
+
+    // nullptr if the ID is not in the index
+    [[nodiscard]] auto find(unsigned int orderId) const -> Order *;
+    [[nodiscard]] auto contains(unsigned int orderId) const -> bool;
+
+    // Insert or overwrite the order stored for orderId
+    void insert(unsigned int orderId, Order *order);
+    // Returns false if the ID was not in the index
+    auto erase(unsigned int orderId) -> bool;
+
+    [[nodiscard]] auto size() const -> std::size_t;
+    [[nodiscard]] auto empty() const -> bool;
+    // Slots of the table, at least twice the largest number of orders held at once
+    [[nodiscard]] auto capacity() const -> std::size_t;
+
+private:
+    struct Slot
+    {
+        unsigned int orderId;
+        Order *order;   // nullptr marks an empty slot
+    };
+
+    std::vector<Slot> slots;
+    std::size_t mask;
+    unsigned int shift;
+    std::size_t orderCount = 0;
+
+    [[nodiscard]] auto home(unsigned int orderId) const -> std::size_t;
+    // Slot holding orderId, or the empty slot ending its probe sequence
+    [[nodiscard]] auto probe(unsigned int orderId) const -> std::size_t;
+    void grow();
+};
+
+#endif // ORDER_ID_INDEX_H
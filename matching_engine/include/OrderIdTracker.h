@@ -0,0 +1,35 @@
+#ifndef ORDER_ID_TRACKER_H
+#define ORDER_ID_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "matching_engine_config.hpp"
+
+// Remembers which order IDs the engine has already seen, in a fixed amount of memory.
+// IDs come from the engine's monotonic ShardIDGenerator, so only a sliding window of the most recent windowSize IDs is
+// tracked exactly, as a ring of bits; the window follows the highest ID inserted. IDs that have fallen
+// below the window are reported as seen: a new order can never legitimately carry one.
+class OrderIdTracker
+{
+public:
+    // windowSize is rounded up to a whole number of 64-bit words, then to a power of two
+    explicit OrderIdTracker(std::size_t windowSize = matchingSystemConfig::mathingEngine::ORDER_ID_WINDOW);
+
+    void insert(unsigned int orderId);
+    [[nodiscard]] auto contains(unsigned int orderId) const -> bool;
+
+    // Highest ID inserted so far, 0 before the first insert
+    [[nodiscard]] auto highWaterMark() const -> unsigned int;
+    // Lowest ID still tracked exactly
+    [[nodiscard]] auto windowStart() const -> unsigned int;
+    [[nodiscard]] auto footprintBytes() const -> std::size_t;
+
+private:
+    std::vector<std::uint64_t> ring;  // Word w of the window lives at ring[w & wordMask]
+    std::size_t wordMask;
+    std::uint64_t baseWord = 0;       // First absolute word index inside the window
+    unsigned int highest = 0;
+};
+
+#endif // ORDER_ID_TRACKER_H
@@ -2,17 +2,32 @@
 #define ORDER_MANAGER_H
 
 #include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
 #include <TCPGateway.h>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
+#include "InputJournal.h"
 #include "Message.hpp"
 #include "MessageQueue.h"
 #include "Order.h"
 #include "OrderBook.h"
+#include "matching_engine_config.hpp"
 
 class OrderManager
 {
 public:
-    OrderManager(MatchingEngine* engine, MessageQueue& messageQueue, TCPGateway* gateway = {});
+    // batchSize > 1 processes up to that many queued messages per round, logging and acknowledging them together.
+    // With a journal every message is appended to it before it is matched and each batch is committed before its
+    // acks go out; under GROUP_COMMIT the acks wait until the syncer has the batch on disk. The journal must
+    // outlive the manager.
+    OrderManager(MatchingEngine* engine, MessageQueue& messageQueue, TCPGateway* gateway = {},
+                 std::size_t batchSize = matchingSystemConfig::orderManager::BATCH_SIZE,
+                 InputJournal* journal = nullptr);
+    ~OrderManager();
 
     OrderManager(const OrderManager&) = delete;
     auto operator=(const OrderManager&) -> OrderManager& = delete;
@@ -25,22 +40,51 @@ public:
 
     auto isRunning() -> bool;
 
+    // Messages taken off the queue and handled by the processing thread so far
+    [[nodiscard]] auto getProcessedCount() const -> std::uint64_t;
+
 private:
     MatchingEngine* matchingEngine; // Matching Engine pointer
     MessageQueue& messageQueue;     // Reference to message queue
     TCPGateway* gateway{};
+    std::size_t batchSize;
+
+    // Acks of the current batch, flushed once it is processed
+    std::vector<TCPGateway::OutgoingMessage> pendingAcks;
+    bool batching = false;
+    InputJournal* journal{};
+    // Acks of committed batches waiting for the journal to be durable, tagged with the batch's last sequence
+    std::mutex heldAcksMutex;
+    std::deque<std::pair<std::uint64_t, std::vector<TCPGateway::OutgoingMessage>>> heldAcks;
+    // Ack buffers the syncer has sent and hands back for reuse, guarded by heldAcksMutex
+    std::vector<std::vector<TCPGateway::OutgoingMessage>> spareAckBuffers;
+    // Trades of the engine's history already handed to the EventLog
+    std::size_t loggedTradeCount = 0;
 
     std::thread messageProcessingThread;      // Thread for processing messages
     std::atomic<bool> managerRunning{false};         // Flag to control message processing loop
+    std::atomic<std::uint64_t> processedCount{0};
 
     // Messages processing loop
     void processLoop();
 
+    void processMessage(const Message& message);
+
+    // Send response to the sender of message, carrying its arrival time for latency tracking
+    void acknowledge(const Message& message, std::string response);
+
+    void flushBatch();
+
+    // Durable callback of the journal, runs on its syncer thread
+    void releaseDurableAcks(std::uint64_t durableCount);
+
+    void logNewTrades();
+
     void handleModifyMessage(const Message& message);
 
     void handleCancelMessage(const Message& message);
 
-    auto createOrder(const AddOrderDetails& details, unsigned int orderID) -> Order* ;
+    auto createOrder(const AddOrderDetails& details, unsigned int orderID, Timestamp timestamp) -> Order* ;
 
 };
 
@@ -0,0 +1,38 @@
+#ifndef ORDER_POOL_H
+#define ORDER_POOL_H
+
+#include <cstddef>
+#include "InstrumentRegistry.hpp"
+#include "Order.h"
+#include "TickSize.hpp"
+#include "matching_engine_config.hpp"
+
+// Owner of every Order of a MatchingEngine.
+// Orders are constructed in place in slab memory and recycled on release, so creating and retiring
+// an order costs a free-list pop/push instead of a heap allocation. The hot Order records of a chunk are
+// packed together, their OrderDetails sit in a separate array of the same chunk. Not thread-safe: orders
+// are created and released on the thread driving the MatchingEngine.
+class OrderPool
+{
+public:
+    // Each chunk holds OrderSlab::OBJECTS_PER_CHUNK orders
+    explicit OrderPool(std::size_t initialChunks = 1);
+
+    OrderPool(const OrderPool&) = delete;
+    auto operator=(const OrderPool&) -> OrderPool& = delete;
+
+    // timestamp is the monotonicNow() reading of the order's arrival, 0 stamps the order on creation
+    auto createLimitOrder(unsigned int id, InstrumentId instrument, Price price, int quantity, bool is_buy, Timestamp timestamp = 0) -> Order *;
+    auto createMarketOrder(unsigned int id, InstrumentId instrument, int quantity, bool is_buy, Timestamp timestamp = 0) -> Order *;
+    auto createStopOrder(unsigned int id, InstrumentId instrument, Price price, int quantity, bool is_buy, Timestamp timestamp = 0) -> Order *;
+
+    // Destroy the order and return its slot to the pool
+    void release(Order *order);
+
+    [[nodiscard]] auto getStats() const -> const SlabPoolStats &;
+
+private:
+    OrderSlab pool;
+};
+
+#endif // ORDER_POOL_H
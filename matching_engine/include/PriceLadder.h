@@ -0,0 +1,253 @@
+#ifndef PRICE_LADDER_H
+#define PRICE_LADDER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <stdexcept>
+#include <vector>
+#include "OccupancyBitmap.h"
+#include "TickSize.hpp"
+
+// Price levels of one side of the book, indexed by tick offset from a moving anchor.
+// Prices inside the window [anchor, anchor + windowSize) live in a contiguous array, so inserting,
+// finding and erasing a level is O(1). Prices outside the window go to an ordered overflow map.
+// The window follows the best price: when a new best price falls outside of it, or when the window
+// runs empty, the ladder is re-anchored around the best price.
+// An occupancy bitmap over the window answers best/neighbour queries with a few ctz/clz instructions.
+template <typename Level>
+class PriceLadder
+{
+public:
+    PriceLadder(std::size_t windowSize, std::size_t headroom, bool higherIsBetter)
+        : slots(windowSize, nullptr), occupied(windowSize), headroom(headroom), higherIsBetter(higherIsBetter)
+    {
+        if (headroom >= windowSize)
+        {
+            throw std::invalid_argument("PriceLadder window must be larger than its headroom.");
+        }
+    }
+
+    [[nodiscard]] auto find(const Price price) const -> Level *
+    {
+        if (inWindow(price))
+        {
+            return slots[index(price)];
+        }
+        const auto iter = overflow.find(price);
+        return (iter != overflow.end()) ? iter->second : nullptr;
+    }
+
+    void insert(const Price price, Level *level)
+    {
+        if (windowCount == 0 || (!inWindow(price) && isBetterThanWindow(price)))
+        {
+            reanchor(price);
+        }
+
+        if (inWindow(price))
+        {
+            slots[index(price)] = level;
+            occupied.set(index(price));
+            ++windowCount;
+        }
+        else
+        {
+            overflow[price] = level;
+        }
+    }
+
+    void erase(const Price price)
+    {
+        if (inWindow(price))
+        {
+            if (slots[index(price)] != nullptr)
+            {
+                slots[index(price)] = nullptr;
+                occupied.clear(index(price));
+                --windowCount;
+            }
+        }
+        else
+        {
+            overflow.erase(price);
+        }
+
+        if (windowCount == 0 && !overflow.empty())
+        {
+            // Keep the best price inside the window
+            reanchor(higherIsBetter ? overflow.rbegin()->first : overflow.begin()->first);
+        }
+    }
+
+    // Nearest occupied level strictly better than price, nullptr if price would be the best
+    [[nodiscard]] auto findBetter(const Price price) const -> Level *
+    {
+        return higherIsBetter ? findAbove(price) : findBelow(price);
+    }
+
+    // Nearest occupied level strictly worse than price, nullptr if price would be the worst
+    [[nodiscard]] auto findWorse(const Price price) const -> Level *
+    {
+        return higherIsBetter ? findBelow(price) : findAbove(price);
+    }
+
+    [[nodiscard]] auto best() const -> Level *
+    {
+        if (empty())
+        {
+            return nullptr;
+        }
+        // Overflow prices beyond the better edge of the window beat everything inside it
+        if (higherIsBetter && !overflow.empty() && overflow.rbegin()->first >= windowEnd())
+        {
+            return overflow.rbegin()->second;
+        }
+        if (!higherIsBetter && !overflow.empty() && overflow.begin()->first < anchor)
+        {
+            return overflow.begin()->second;
+        }
+        if (windowCount > 0)
+        {
+            const std::size_t slot = higherIsBetter ? occupied.findPrev(slots.size() - 1) : occupied.findNext(0);
+            return slots[slot];
+        }
+        return higherIsBetter ? overflow.rbegin()->second : overflow.begin()->second;
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return windowCount + overflow.size();
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+    [[nodiscard]] auto getAnchor() const -> Price
+    {
+        return anchor;
+    }
+
+    [[nodiscard]] auto overflowSize() const -> std::size_t
+    {
+        return overflow.size();
+    }
+
+private:
+    std::vector<Level *> slots;
+    OccupancyBitmap occupied;
+    std::map<Price, Level *> overflow;
+    Price anchor = 0;
+    std::size_t windowCount = 0;
+    std::size_t headroom;   // Free ticks kept on the better side of the best price after re-anchoring
+    bool higherIsBetter;
+
+    [[nodiscard]] auto windowEnd() const -> Price
+    {
+        return anchor + static_cast<Price>(slots.size());
+    }
+
+    [[nodiscard]] auto inWindow(const Price price) const -> bool
+    {
+        return price >= anchor && price < windowEnd();
+    }
+
+    [[nodiscard]] auto index(const Price price) const -> std::size_t
+    {
+        return static_cast<std::size_t>(price - anchor);
+    }
+
+    [[nodiscard]] auto isBetterThanWindow(const Price price) const -> bool
+    {
+        return higherIsBetter ? price >= windowEnd() : price < anchor;
+    }
+
+    // Nearest occupied level strictly above price, from the window or the overflow map
+    auto findAbove(const Price price) const -> Level *
+    {
+        Level *windowLevel = nullptr;
+        Price windowPrice = 0;
+        if (windowCount > 0 && price + 1 < windowEnd())
+        {
+            const Price from = std::max(price + 1, anchor);
+            if (const std::size_t slot = occupied.findNext(index(from)); slot != OccupancyBitmap::npos)
+            {
+                windowLevel = slots[slot];
+                windowPrice = anchor + static_cast<Price>(slot);
+            }
+        }
+
+        const auto iter = overflow.upper_bound(price);
+        if (iter == overflow.end())
+        {
+            return windowLevel;
+        }
+        if (windowLevel == nullptr || iter->first < windowPrice)
+        {
+            return iter->second;
+        }
+        return windowLevel;
+    }
+
+    // Nearest occupied level strictly below price, from the window or the overflow map
+    auto findBelow(const Price price) const -> Level *
+    {
+        Level *windowLevel = nullptr;
+        Price windowPrice = 0;
+        if (windowCount > 0 && price - 1 >= anchor)
+        {
+            const Price from = std::min(price - 1, windowEnd() - 1);
+            if (const std::size_t slot = occupied.findPrev(index(from)); slot != OccupancyBitmap::npos)
+            {
+                windowLevel = slots[slot];
+                windowPrice = anchor + static_cast<Price>(slot);
+            }
+        }
+
+        auto iter = overflow.lower_bound(price);
+        if (iter == overflow.begin())
+        {
+            return windowLevel;
+        }
+        --iter;
+        if (windowLevel == nullptr || iter->first > windowPrice)
+        {
+            return iter->second;
+        }
+        return windowLevel;
+    }
+
+    void reanchor(const Price bestPrice)
+    {
+        const auto window = static_cast<Price>(slots.size());
+        const Price newAnchor = higherIsBetter ? bestPrice - (window - 1 - static_cast<Price>(headroom))
+                                               : bestPrice - static_cast<Price>(headroom);
+        if (newAnchor == anchor)
+        {
+            return;
+        }
+
+        // Spill the current window into the overflow map, then pull everything inside the new window back
+        for (std::size_t slot = occupied.findNext(0); slot != OccupancyBitmap::npos; slot = occupied.findNext(slot + 1))
+        {
+            overflow.emplace(anchor + static_cast<Price>(slot), slots[slot]);
+            slots[slot] = nullptr;
+            occupied.clear(slot);
+        }
+        windowCount = 0;
+
+        anchor = newAnchor;
+        auto iter = overflow.lower_bound(anchor);
+        while (iter != overflow.end() && iter->first < windowEnd())
+        {
+            slots[index(iter->first)] = iter->second;
+            occupied.set(index(iter->first));
+            ++windowCount;
+            iter = overflow.erase(iter);
+        }
+    }
+};
+
+#endif // PRICE_LADDER_H
@@ -0,0 +1,69 @@
+#ifndef SHARDED_MATCHING_ENGINE_H
+#define SHARDED_MATCHING_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "InputJournal.h"
+#include "MatchingEngine.h"
+#include "MessageQueue.h"
+#include "MessageRouter.hpp"
+#include "OrderManager.h"
+#include "TCPGateway.h"
+#include "matching_engine_config.hpp"
+
+// Spreads instruments over several matching threads.
+// Every shard owns a MatchingEngine with the books of its instruments and its own ID space, an inbound queue and
+// the OrderManager thread draining it, so shards never share book state or an ID counter. The router sends each message to the shard owning its
+// instrument, which keeps the order of messages strict per instrument. With a tradeLogPrefix, shard i spills its
+// trade history to <prefix>_shard<i>.bin, with a journalPrefix it journals its input to <prefix>_shard<i>.journal.
+class ShardedMatchingEngine
+{
+public:
+    explicit ShardedMatchingEngine(std::size_t shardCount = matchingSystemConfig::shardedEngine::SHARD_COUNT,
+                                   MessageQueue::WaitStrategy waitStrategy = MessageQueue::WaitStrategy::SPIN_PARK,
+                                   std::size_t queueCapacity = Utility_Config::MessageQueue::DEFAULT_CAPACITY,
+                                   const std::string &tradeLogPrefix = {},
+                                   const std::string &journalPrefix = {},
+                                   JournalSyncPolicy journalPolicy = JournalSyncPolicy::PERIODIC);
+    ~ShardedMatchingEngine();
+
+    ShardedMatchingEngine(const ShardedMatchingEngine&) = delete;
+    auto operator=(const ShardedMatchingEngine&) -> ShardedMatchingEngine& = delete;
+
+    // Registers the symbol and creates its book on the owning shard, see MatchingEngine::createNewOrderBook
+    auto createNewOrderBook(const std::string &instrument,
+                            double tickSize = Utility_Config::Tick::DEFAULT_TICK_SIZE,
+                            std::size_t expectedOrders = matchingSystemConfig::orderBook::EXPECTED_RESTING_ORDERS) -> bool;
+
+    // Starts one OrderManager thread per shard, acks go out through gateway when it is set
+    void start(TCPGateway* gateway = nullptr);
+    void stop();
+    [[nodiscard]] auto isRunning() const -> bool;
+
+    // Router over the shard queues, for the gateway or any other producer thread
+    [[nodiscard]] auto getRouter() const -> MessageRouter;
+
+    [[nodiscard]] auto getShardCount() const -> std::size_t;
+    [[nodiscard]] auto getShardIndex(InstrumentId instrument) const -> std::size_t;
+    auto getEngine(std::size_t shard) -> MatchingEngine &;
+    auto getEngineFor(InstrumentId instrument) -> MatchingEngine &;
+
+    // Messages handled by all shards so far
+    [[nodiscard]] auto getProcessedCount() const -> std::uint64_t;
+
+private:
+    struct Shard {
+        std::unique_ptr<MessageQueue> queue;
+        std::unique_ptr<MatchingEngine> engine;
+        std::unique_ptr<InputJournal> journal;    // Outlives the manager writing to it
+        std::unique_ptr<OrderManager> manager;
+    };
+
+    std::vector<Shard> shards;
+    bool running = false;
+};
+
+#endif // SHARDED_MATCHING_ENGINE_H
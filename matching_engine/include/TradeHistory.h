@@ -0,0 +1,55 @@
+#ifndef TRADE_HISTORY_H
+#define TRADE_HISTORY_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Trade.h"
+#include "TradeLog.h"
+#include "matching_engine_config.hpp"
+
+// Trades produced by one engine.
+// The most recent recentCapacity trades stay in a fixed ring in memory; when a log path is given, every trade
+// is also appended to a memory-mapped TradeLog holding the full history. Recording never reallocates the ring.
+class TradeHistory
+{
+public:
+    // An empty logPath keeps only the in-memory ring
+    explicit TradeHistory(std::size_t recentCapacity = matchingSystemConfig::tradeHistory::RECENT_CAPACITY,
+                          const std::string &logPath = {});
+
+    TradeHistory(const TradeHistory &) = delete;
+    auto operator=(const TradeHistory &) -> TradeHistory & = delete;
+
+    void record(const Trade &trade);
+
+    // Trades recorded since the engine started, including those that left the ring
+    [[nodiscard]] auto totalCount() const -> std::size_t;
+    [[nodiscard]] auto recentCount() const -> std::size_t;
+    // index 0 is the oldest trade still in the ring
+    [[nodiscard]] auto recent(std::size_t index) const -> const Trade &;
+
+    template <typename Visitor>
+    void forEachRecent(Visitor &&visitor) const
+    {
+        for (std::size_t i = 0; i < ring.size(); ++i)
+        {
+            visitor(recent(i));
+        }
+    }
+
+    // Copies the ring, oldest first
+    [[nodiscard]] auto copyRecent() const -> std::vector<Trade>;
+
+    // nullptr when the history is not spilled to disk
+    [[nodiscard]] auto getLog() const -> const TradeLog *;
+
+private:
+    std::size_t capacity;
+    std::vector<Trade> ring;
+    std::size_t total = 0;
+    std::unique_ptr<TradeLog> log;
+};
+
+#endif // TRADE_HISTORY_H
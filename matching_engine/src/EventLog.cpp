@@ -0,0 +1,228 @@
+#include "EventLog.h"
+#include <chrono>
+#include "Logger.hpp"
+#include "TradeFormat.h"
+
+thread_local EventLog::Ring *EventLog::local = nullptr;
+
+auto EventLog::getInstance() -> EventLog &
+{
+    static EventLog instance;
+    return instance;
+}
+
+void EventLog::start()
+{
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (users++ == 0)
+    {
+        running = true;
+        formatter = std::thread(&EventLog::formatLoop, this);
+    }
+}
+
+void EventLog::stop()
+{
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (users == 0 || --users != 0)
+    {
+        return;
+    }
+    running = false;
+    if (formatter.joinable())
+    {
+        formatter.join();
+    }
+}
+
+void EventLog::logMessage(const Message &message)
+{
+    push(fromMessage(message));
+}
+
+void EventLog::logTrade(const Trade &trade)
+{
+    push(fromTrade(trade));
+}
+
+auto EventLog::drain() -> std::size_t
+{
+    std::string orderLines;
+    std::string tradeLines;
+    std::size_t drained = 0;
+    std::uint64_t dropped = 0;
+    std::uint64_t newlyDropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (const auto &ring : rings)
+        {
+            const std::uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+            const std::uint64_t head = ring->head.load(std::memory_order_acquire);
+            for (std::uint64_t index = tail; index < head; ++index)
+            {
+                const EventRecord &record = ring->records[index & (RING_CAPACITY - 1)];
+                std::string &lines = record.type == EventType::TRADE ? tradeLines : orderLines;
+                lines += format(record, matchingSystemConfig::eventLog::FORMAT);
+                lines += '\n';
+            }
+            ring->tail.store(head, std::memory_order_release);
+            drained += static_cast<std::size_t>(head - tail);
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+        }
+        newlyDropped = dropped - reportedDropped;
+        reportedDropped = dropped;
+    }
+
+    // Lines lost to a full ring leave a mark where they are missing
+    if (newlyDropped != 0)
+    {
+        Logger::getLogger(matchingSystemConfig::mathingEngine::LOGGER_NAME)->warn(
+            "{} order and trade log records dropped, a matching thread filled its event ring", newlyDropped);
+    }
+
+    // One logger call per kind and drain, the logger adds the last newline itself
+    if (!orderLines.empty())
+    {
+        orderLines.pop_back();
+        Logger::getLogger(matchingSystemConfig::orderManager::LOGGER_NAME)->info(orderLines);
+    }
+    if (!tradeLines.empty())
+    {
+        tradeLines.pop_back();
+        Logger::getLogger(matchingSystemConfig::mathingEngine::LOGGER_NAME)->info(tradeLines);
+    }
+    return drained;
+}
+
+auto EventLog::droppedCount() const -> std::uint64_t
+{
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    std::uint64_t dropped = 0;
+    for (const auto &ring : rings)
+    {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+auto EventLog::fromMessage(const Message &message) -> EventRecord
+{
+    EventRecord record{};
+    switch (message.type)
+    {
+    case MessageType::ADD_ORDER:
+    {
+        const AddOrderDetails &details = *message.addOrderDetails;
+        record.type = EventType::ADD_ORDER;
+        record.instrument = details.instrument;
+        record.price = details.price;
+        record.quantity = details.quantity;
+        record.isBuy = details.isBuy;
+        record.orderType = details.type;
+        break;
+    }
+    case MessageType::MODIFY_ORDER:
+    {
+        const ModifyOrderDetails &details = *message.modifyDetails;
+        record.type = EventType::MODIFY_ORDER;
+        record.id = details.orderId;
+        record.instrument = details.instrument;
+        record.price = details.newPrice;
+        record.quantity = details.newQuantity;
+        break;
+    }
+    case MessageType::CANCEL_ORDER:
+    {
+        const CancelOrderDetails &details = *message.cancelDetails;
+        record.type = EventType::CANCEL_ORDER;
+        record.id = details.orderId;
+        record.instrument = details.instrument;
+        break;
+    }
+    default:
+        throw std::invalid_argument("Only order messages can be logged.");
+    }
+    return record;
+}
+
+auto EventLog::fromTrade(const Trade &trade) -> EventRecord
+{
+    EventRecord record{};
+    record.type = EventType::TRADE;
+    record.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(trade.getTimestamp().time_since_epoch()).count();
+    record.price = trade.getPrice();
+    record.id = trade.getTradeId();
+    record.buyOrderId = trade.getBuyOrderId();
+    record.sellOrderId = trade.getSellOrderId();
+    record.quantity = trade.getQuantity();
+    record.buyLeavesQuantity = trade.getBuyLeavesQuantity();
+    record.sellLeavesQuantity = trade.getSellLeavesQuantity();
+    record.instrument = trade.getInstrument();
+    record.buyStatus = trade.getBuyOrderStatus();
+    record.sellStatus = trade.getSellOrderStatus();
+    return record;
+}
+
+auto EventLog::format(const EventRecord &record, const std::string &format) -> std::string
+{
+    switch (record.type)
+    {
+    case EventType::ADD_ORDER:
+        return AddOrderDetails(record.instrument, record.price, record.quantity, record.isBuy, record.orderType).toString(format);
+    case EventType::MODIFY_ORDER:
+        return ModifyOrderDetails(record.id, record.instrument, record.price, record.quantity).toString(format);
+    case EventType::CANCEL_ORDER:
+        return CancelOrderDetails(record.id, record.instrument).toString(format);
+    case EventType::TRADE:
+    {
+        Trade trade(record.id, record.buyOrderId, record.sellOrderId, record.instrument, record.price, record.quantity,
+                    std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::nanoseconds(record.timestampNs))));
+        trade.setBuyOrderStatus(record.buyStatus);
+        trade.setSellOrderStatus(record.sellStatus);
+        trade.setBuyLeavesQuantity(record.buyLeavesQuantity);
+        trade.setSellLeavesQuantity(record.sellLeavesQuantity);
+        return formatTrade(trade, format);
+    }
+    default:
+        throw std::invalid_argument("Unknown event type.");
+    }
+}
+
+void EventLog::push(const EventRecord &record)
+{
+    Ring &ring = localRing();
+    const std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) == RING_CAPACITY)
+    {
+        ring.dropped.store(ring.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    ring.records[head & (RING_CAPACITY - 1)] = record;
+    ring.head.store(head + 1, std::memory_order_release);
+}
+
+auto EventLog::localRing() -> Ring &
+{
+    if (local == nullptr)
+    {
+        auto ring = std::make_unique<Ring>();
+        local = ring.get();
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.push_back(std::move(ring));
+    }
+    return *local;
+}
+
+void EventLog::formatLoop()
+{
+    while (running)
+    {
+        if (drain() == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(matchingSystemConfig::eventLog::IDLE_SLEEP_US));
+        }
+    }
+    // Whatever the matching threads logged before they stopped
+    drain();
+}
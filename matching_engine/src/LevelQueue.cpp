@@ -0,0 +1,107 @@
+#include <stdexcept>
+#include "LevelQueue.h"
+
+LevelQueue::LevelQueue(const std::size_t initialCapacity)
+{
+    entries.reserve(initialCapacity);
+}
+
+auto LevelQueue::push(const unsigned int orderId, const int quantity, Order *order) -> Position
+{
+    if (quantity <= 0)
+    {
+        throw std::invalid_argument("LevelQueue entry quantity must be greater than 0.");
+    }
+    entries.push_back({orderId, quantity, order});
+    ++live;
+    totalQuantity += quantity;
+    return static_cast<Position>(entries.size() - 1);
+}
+
+void LevelQueue::cancel(const Position position)
+{
+    Entry &entry = liveEntry(position);
+    totalQuantity -= entry.quantity;
+    entry.quantity = 0;
+    --live;
+    ++tombstones;
+    recycleIfEmpty();
+}
+
+void LevelQueue::reduce(const Position position, const int newQuantity)
+{
+    if (newQuantity <= 0)
+    {
+        cancel(position);
+        return;
+    }
+    Entry &entry = liveEntry(position);
+    if (newQuantity > entry.quantity)
+    {
+        throw std::invalid_argument("LevelQueue::reduce cannot increase the quantity of an entry.");
+    }
+    totalQuantity += newQuantity - entry.quantity;
+    entry.quantity = newQuantity;
+}
+
+auto LevelQueue::at(const Position position) const -> const Entry &
+{
+    return entries.at(position);
+}
+
+auto LevelQueue::front() -> const Entry *
+{
+    while (head < entries.size() && entries[head].quantity == 0)
+    {
+        --tombstones;
+        ++head;
+    }
+    return (head < entries.size()) ? &entries[head] : nullptr;
+}
+
+auto LevelQueue::needsCompaction() const -> bool
+{
+    // Consumed slots before head count as well: compacting also gives their storage back to the tail
+    const std::size_t dead = head + tombstones;
+    return dead >= matchingSystemConfig::orderBook::LEVEL_QUEUE_MIN_COMPACTION && dead > live;
+}
+
+auto LevelQueue::getTotalQuantity() const -> int
+{
+    return totalQuantity;
+}
+
+auto LevelQueue::liveCount() const -> std::size_t
+{
+    return live;
+}
+
+auto LevelQueue::tombstoneCount() const -> std::size_t
+{
+    return tombstones;
+}
+
+auto LevelQueue::empty() const -> bool
+{
+    return live == 0;
+}
+
+auto LevelQueue::liveEntry(const Position position) -> Entry &
+{
+    if (position < head || position >= entries.size() || entries[position].quantity == 0)
+    {
+        throw std::out_of_range("LevelQueue position does not hold a live entry.");
+    }
+    return entries[position];
+}
+
+void LevelQueue::recycleIfEmpty()
+{
+    // Nothing left to keep, the storage starts over from slot 0 without moving anything
+    if (live == 0)
+    {
+        entries.clear();
+        head = 0;
+        tombstones = 0;
+    }
+}
@@ -1,53 +1,84 @@
 #include <iostream>
+#include <algorithm>
 #include <vector>
 #include "MatchingEngine.h"
-#include "Logger.hpp"
 #include "matching_engine_config.hpp"
 #include "Trade.h"
 #include "Order.h"
 #include "OrderBook.h"
-#include "IDGenerator.hpp"
+#include "TimestampUtility.h"
 #include "OrderType.h"
 
-MatchingEngine::MatchingEngine()
+MatchingEngine::MatchingEngine() : MatchingEngine(std::string())
 {
-    orderBooks = std::unordered_map<std::string, OrderBook *>();
+}
+
+MatchingEngine::MatchingEngine(const std::string &tradeLogPath, const unsigned int shardIndex,
+                               const unsigned int shardBits)
+    : idGenerator(shardIndex, shardBits), tradeHistory(matchingSystemConfig::tradeHistory::RECENT_CAPACITY, tradeLogPath)
+{
+    // Books and last traded prices are indexed directly by InstrumentId
+    for (std::atomic<OrderBook *> &orderBook : orderBooks)
+    {
+        orderBook.store(nullptr, std::memory_order_relaxed);
+    }
 
-    instrumentToTradedPrice = std::unordered_map<std::string, double>();
+    instrumentToTradedPrice = std::vector<Price>(InstrumentRegistry::MAX_INSTRUMENTS, 0);
 
-    trades = std::vector<Trade>();
+    // A reopened log continues from an earlier run, its trade IDs must keep increasing for TradeLog::lowerBound
+    if (const TradeLog *log = tradeHistory.getLog(); log != nullptr && !log->empty())
+    {
+        idGenerator.advanceTradeIDs(log->at(log->size() - 1).getTradeId() + 1);
+    }
 }
 
 MatchingEngine::~MatchingEngine()
 {
-
+    for (std::size_t instrument = 0; instrument < orderBooks.size(); ++instrument)
+    {
+        if (const OrderBook *orderBook = orderBooks[instrument].load(std::memory_order_relaxed); orderBook != nullptr)
+        {
+            InstrumentRegistry::getInstance().detachBook(static_cast<InstrumentId>(instrument));
+            delete orderBook;
+        }
+    }
 }
 
-bool MatchingEngine::createNewOrderBook(const std::string &instrument)
+bool MatchingEngine::createNewOrderBook(const std::string &instrument, const double tickSize,
+                                        const std::size_t expectedOrders)
 {
     {
-        std::unique_lock<std::shared_mutex> lock(orderBooksMutex);  // 写锁
-        if (orderBooks.find(instrument) != orderBooks.end()) {
+        std::lock_guard<std::mutex> lock(orderBooksWriteMutex);  // 写锁
+        InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+        // Check before registering, registration must not touch the tick size a live book is indexed by
+        if (const InstrumentId existing = registry.find(instrument);
+            existing != InstrumentRegistry::INVALID_ID && orderBooks[existing].load(std::memory_order_relaxed) != nullptr) {
+            if (registry.getTickSize(existing) != tickSize) {
+                throw std::invalid_argument("Order book of " + instrument + " already exists with another tick size.");
+            }
             return false; // 已存在
         }
-        auto *newOrderBook = new OrderBook(instrument);
+        // The gateway resolves the symbol and converts decimal prices with the same tick size the book is indexed by
+        const InstrumentId instrumentId = registry.attachBook(instrument, tickSize);
+        auto *newOrderBook = new OrderBook(instrumentId, tickSize, orderPool, expectedOrders);
         newOrderBook->setCrossCallback(
-            [this](Order* order) { this->processNewOrder(order); }
+            [this](Order* order) { this->processNewOrder(order, *executionSink); }
         );
-        orderBooks[instrument] = newOrderBook;
-        instrumentToTradedPrice[instrument] = 0.0;
+        instrumentToTradedPrice[instrumentId] = 0;
+        // Release store: a reader seeing the pointer sees the fully built book
+        orderBooks[instrumentId].store(newOrderBook, std::memory_order_release);
     }
     return true;
 }
 
-void MatchingEngine::removeOrderBook(const std::string &instrument)
+void MatchingEngine::removeOrderBook(const InstrumentId instrument)
 {
-    std::unique_lock lock(orderBooksMutex);
-    auto iter = orderBooks.find(instrument);
-    if (iter != orderBooks.end())
+    std::lock_guard<std::mutex> lock(orderBooksWriteMutex);
+    OrderBook *orderBook = (instrument < orderBooks.size()) ? orderBooks[instrument].exchange(nullptr) : nullptr;
+    if (orderBook != nullptr)
     {
-        delete iter->second;
-        orderBooks.erase(iter);
+        retiredOrderBooks.emplace_back(orderBook);
+        InstrumentRegistry::getInstance().detachBook(instrument);
         std::cout << "Target instrument has been removed successfully." << '\n';
     } 
     else 
@@ -56,47 +87,72 @@ void MatchingEngine::removeOrderBook(const std::string &instrument)
     }
 }
 
-auto MatchingEngine::processNewOrder(Order *order) -> std::vector<Trade>
+auto MatchingEngine::getOrderPool() -> OrderPool &
 {
-    std::vector<Trade> trades;
+    return orderPool;
+}
 
+void MatchingEngine::processNewOrder(Order *order, ExecutionSink &sink)
+{
     const OrderType type = order->getType();
 
-    globalOrderIds.insert(order->getId());
+    seenOrderIds.insert(order->getId());
 
     // Matching processing logic according to order type
     if (type == OrderType::LIMIT)
     {
-        trades = MatchingEngine::processLimitOrder(order);
+        processLimitOrder(order, sink);
     }
     else if (type == OrderType::MARKET)
     {
-        trades = MatchingEngine::processMarketOrder(order);
+        processMarketOrder(order, sink);
     }
     else if (type == OrderType::STOP)
     {
-        trades = MatchingEngine::processStopOrder(order);
+        processStopOrder(order, sink);
     }
     else
     {
         throw std::invalid_argument("Unknown Order Type.");
     }
+}
 
-
-    auto logger = Logger::getLogger(matchingSystemConfig::mathingEngine::LOGGER_NAME);
-    for (const auto& trade : trades) {
-        logger->info(trade.toString());
-    }
-    this->trades.insert(this->trades.end(), trades.begin(), trades.end());
-    
+auto MatchingEngine::processNewOrder(Order *order) -> std::vector<Trade>
+{
+    std::vector<Trade> trades;
+    TradeCollector collector(trades);
+    processNewOrder(order, collector);
     return trades;
 }
 
-void MatchingEngine::cancelOrder(const unsigned int orderId, const std::string &instrument)
+void MatchingEngine::setExecutionSink(ExecutionSink *sink)
+{
+    executionSink = (sink != nullptr) ? sink : &nullSink;
+}
+
+auto MatchingEngine::getExecutionSink() -> ExecutionSink &
+{
+    return *executionSink;
+}
+
+void MatchingEngine::cancelOrder(const unsigned int orderId, const InstrumentId instrument)
 {
     OrderBook *orderBook = getOrderBook(instrument);
+    if (orderBook == nullptr)
+    {
+        // The registry keeps the symbol of a removed book, so orders for it are still routed here
+        std::cerr << "Order book of instrument " << instrument << " not found.\n";
+        return;
+    }
 
-    if (const OrderType type = orderBook->orderIdToOrderNode[orderId]->order->getType(); type == OrderType::LIMIT)
+    const Order *order = orderBook->orderIdToOrder.find(orderId);
+    if (order == nullptr)
+    {
+        std::cerr << "Order ID " << orderId << " not found.\n";
+        return;
+    }
+
+    if (const OrderType type = order->getType(); type == OrderType::LIMIT)
     {
         orderBook->cancelLimitOrder(orderId);
     }
@@ -111,11 +167,24 @@ void MatchingEngine::cancelOrder(const unsigned int orderId, const std::string &
     
 }
 
-void MatchingEngine::modifyOrder(unsigned int orderId, const std::string &instrument, double newPrice, int newQuantity)
+void MatchingEngine::modifyOrder(unsigned int orderId, const InstrumentId instrument, Price newPrice, int newQuantity)
 {
     OrderBook *orderBook = getOrderBook(instrument);
+    if (orderBook == nullptr)
+    {
+        // The registry keeps the symbol of a removed book, so orders for it are still routed here
+        std::cerr << "Order book of instrument " << instrument << " not found.\n";
+        return;
+    }
 
-    if (OrderType type = orderBook->orderIdToOrderNode[orderId]->order->getType(); type == OrderType::LIMIT)
+    const Order *order = orderBook->orderIdToOrder.find(orderId);
+    if (order == nullptr)
+    {
+        std::cerr << "Order ID " << orderId << " not found.\n";
+        return;
+    }
+
+    if (OrderType type = order->getType(); type == OrderType::LIMIT)
     {
         orderBook->modifyLimitOrder(orderId, newPrice, newQuantity);
     }
@@ -132,48 +201,48 @@ void MatchingEngine::modifyOrder(unsigned int orderId, const std::string &instru
 
 auto MatchingEngine::getTrades()  -> std::vector<Trade>
 {
-    return trades;
+    return tradeHistory.copyRecent();
 }
 
-auto MatchingEngine::getLastTradePrice(const std::string &instrument) -> double
+auto MatchingEngine::getTradeHistory() const -> const TradeHistory &
+{
+    return tradeHistory;
+}
+
+auto MatchingEngine::getLastTradePrice(const InstrumentId instrument) -> Price
 {
     return instrumentToTradedPrice[instrument];
 }
 
-auto MatchingEngine::getOrderBookForRead(const std::string &instrument) -> const OrderBook *
+auto MatchingEngine::getOrderBookForRead(const InstrumentId instrument) -> const OrderBook *
 {
-    std::shared_lock lock(orderBooksMutex);
-    const auto iter = orderBooks.find(instrument);
-    return (iter != orderBooks.end()) ? iter->second : nullptr;
+    return getOrderBook(instrument);
 }
 
-auto MatchingEngine::hasOrder(const std::string& instrument, unsigned int orderId) -> bool
+auto MatchingEngine::hasOrder(const InstrumentId instrument, unsigned int orderId) -> bool
 {   
-    OrderBook *book = orderBooks[instrument];
-    return (book->orderIdToOrderNode.find(orderId) != book->orderIdToOrderNode.end());
+    const OrderBook *book = getOrderBook(instrument);
+    return book != nullptr && book->orderIdToOrder.contains(orderId);
 }
 
-auto MatchingEngine::hasInstrument(const std::string& instrument) -> bool
+auto MatchingEngine::hasInstrument(const InstrumentId instrument) -> bool
 {
-    if (const auto iter = orderBooks.find(instrument); iter == orderBooks.end())
-    {
-        return false;
-    }
-    {
-        return true;
-    }
+    return getOrderBook(instrument) != nullptr;
 }
 
 auto MatchingEngine::hasOrderId(const unsigned int orderId) -> bool
 {
-    return (globalOrderIds.find(orderId) != globalOrderIds.end());
+    return seenOrderIds.contains(orderId);
 }
 
-auto MatchingEngine::processLimitOrder(Order *order) -> std::vector<Trade>
+auto MatchingEngine::getIDGenerator() -> ShardIDGenerator &
+{
+    return idGenerator;
+}
+
+void MatchingEngine::processLimitOrder(Order *order, ExecutionSink &sink)
 {   
-    // If limit order does not enter the matching process, this vector is empty
-    std::vector<Trade> trades;
-    OrderBook *orderBook = getOrderBook(order->getAsset());
+    OrderBook *orderBook = getOrderBook(order->getInstrument());
 
     const bool isBuy = order->isBuy();
     const OrderBook::PriceLevel *bestLevel = isBuy ? orderBook->bestAskLevel : orderBook->bestBidLevel;
@@ -185,21 +254,24 @@ auto MatchingEngine::processLimitOrder(Order *order) -> std::vector<Trade>
 
     if (shouldMatch)
     {
-        trades = matchOrder(order);
+        matchOrder(order, sink);
     }
 
     if (order->getQuantity() > 0)
     {
         orderBook->addLimitOrderToBook(order);
     }
-
-    return trades;
+    else
+    {
+        // Fully filled on arrival, it never rests in the book
+        orderPool.release(order);
+    }
 }
 
-auto MatchingEngine::processMarketOrder(Order *order) -> std::vector<Trade>
+void MatchingEngine::processMarketOrder(Order *order, ExecutionSink &sink)
 {
     const int originalQuantity = order->getQuantity();
-    std::vector<Trade> trades = matchOrder(order);
+    matchOrder(order, sink);
     const int newQuantity = order->getQuantity();
 
     if (order->getQuantity() > 0)
@@ -208,15 +280,14 @@ auto MatchingEngine::processMarketOrder(Order *order) -> std::vector<Trade>
         << originalQuantity - newQuantity << "filled." << "remaining Quantity: " 
         << newQuantity << "\n";
     }
-    delete order;
-    return trades;
+    orderPool.release(order);
 }
 
-auto MatchingEngine::processStopOrder(Order *order) -> std::vector<Trade>
+void MatchingEngine::processStopOrder(Order *order, ExecutionSink &/*sink*/)
 {
     // TODO: Stop Order logic
     bool isBuy = order->isBuy();
-    double price = order->getPrice();
+    Price price = order->getPrice();
 
     if (isBuy)
     {
@@ -226,29 +297,47 @@ auto MatchingEngine::processStopOrder(Order *order) -> std::vector<Trade>
         }
         
     }
-    
-    return {};
 }
 
 
-auto MatchingEngine::matchOrder(Order *order) -> std::vector<Trade>
+void MatchingEngine::matchOrder(Order *order, ExecutionSink &sink)
 {   
     // TODO: Trigger logic for Stop Order
-    std::vector<Trade> trades;
-
-    const std::string instrument = order->getAsset();
+    const InstrumentId instrument = order->getInstrument();
     OrderBook *orderBook = getOrderBook(instrument);
     int remainingQuantity = order->getQuantity();
     bool is_buy = order->isBuy();
 
+    // Every fill of this order carries the order's gateway arrival time, nothing on this path reads the clock.
+    // Trades keep wall time since the trade log outlives the process, converting is a multiply-add
+    const auto matchTime = toWallClock(order->getTimestamp());
+
+    // Statuses and leaves of both sides are final when a fill is made: the maker keeps makerLeaves,
+    // the taker keeps whatever remainingQuantity is left after it
+    auto emitFill = [&](const Order *maker, const Price price, const int quantity, const int makerLeaves)
+    {
+        Trade trade(idGenerator.getNextTradeID(),
+            is_buy ? order->getId() : maker->getId(),
+            is_buy ? maker->getId() : order->getId(),
+            instrument,
+            price,
+            quantity,
+            matchTime);
+        const TradeStatus makerStatus = makerLeaves != 0 ? TradeStatus::PARTIALLY_FILLED : TradeStatus::SUCCESS;
+        const TradeStatus takerStatus = remainingQuantity != 0 ? TradeStatus::PARTIALLY_FILLED : TradeStatus::SUCCESS;
+        trade.setBuyOrderStatus(is_buy ? takerStatus : makerStatus);
+        trade.setSellOrderStatus(is_buy ? makerStatus : takerStatus);
+        trade.setBuyLeavesQuantity(is_buy ? remainingQuantity : makerLeaves);
+        trade.setSellLeavesQuantity(is_buy ? makerLeaves : remainingQuantity);
+        emitTrade(trade, sink);
+    };
+
     // Determine the best opposite quote
     OrderBook::PriceLevel *bestLevel = is_buy ? orderBook->bestAskLevel:orderBook->bestBidLevel;
 
     while (remainingQuantity > 0 && bestLevel != nullptr)
     {
-        // Iterate PriceLevel one by one
-        OrderBook::OrderNode *oppositeOrderNode = bestLevel -> headOrder;
-        double tradedPrice = bestLevel->price;
+        Price tradedPrice = bestLevel->price;
 
         if (order->getType() == OrderType::LIMIT)
         {
@@ -259,97 +348,71 @@ auto MatchingEngine::matchOrder(Order *order) -> std::vector<Trade>
                 break;
             }
         }
+        instrumentToTradedPrice[instrument] = tradedPrice;
 
-        while (remainingQuantity > 0 && oppositeOrderNode != nullptr)
+        if (remainingQuantity >= bestLevel->totalQuantity)
         {
-            // Iterate all the OrderNodes within a PriceLevel
-            Order *oppositeOrder = oppositeOrderNode -> order;
-            int oppositeQuantity = oppositeOrder->getQuantity();
-            const int tradedQuantity = std::min(oppositeQuantity, remainingQuantity);
-            const unsigned int newTradeId = IDGenerator::getInstance().getNextTradeID();
-
-            Trade trade(newTradeId,
-                is_buy ? order->getId() : oppositeOrder->getId(),
-                is_buy ? oppositeOrder->getId() : order->getId(),
-                instrument,
-                tradedPrice,
-                tradedQuantity);
-            trades.push_back(trade);
-
-            // Update taker
-            remainingQuantity -= tradedQuantity;
-
-            // Update maker
-            if (oppositeOrder->getQuantity() == tradedQuantity) {
-                // If the opposite orderNode's quantity is 0, we need to remove the node and delete the order
-                // When we remove the order, it will perform level quantity update and level delete automatically
-                orderBook -> orderIdToOrderNode.erase(oppositeOrder->getId());
-                OrderBook::OrderNode *nextNode = oppositeOrderNode->next;
-                orderBook -> removeOrderNodeFromBook(oppositeOrderNode);
-                delete oppositeOrder;
-                oppositeOrderNode = nextNode;
-
-                if (oppositeOrderNode == nullptr)
-                {
-                    bestLevel = is_buy ? orderBook->bestAskLevel : orderBook->bestBidLevel;
-                }
-            }
-            else
+            // The whole level is taken: every maker fills completely, so the orders are released as they are
+            // walked and the level leaves the book once, without unlinking or re-summing order by order
+            Order *oppositeOrder = bestLevel->headOrder;
+            while (oppositeOrder != nullptr)
             {
-                // Update quantity of the bestLevel
-                bestLevel->totalQuantity -= tradedQuantity;
-                oppositeOrder->setQuantity(oppositeQuantity - tradedQuantity);
+                Order *nextOrder = oppositeOrder->next;
+                const int tradedQuantity = oppositeOrder->getQuantity();
+                remainingQuantity -= tradedQuantity;
+                emitFill(oppositeOrder, tradedPrice, tradedQuantity, 0);
+                orderBook->orderIdToOrder.erase(oppositeOrder->getId());
+                orderPool.release(oppositeOrder);
+                oppositeOrder = nextOrder;
             }
+            bestLevel->headOrder = nullptr;
+            bestLevel->tailOrder = nullptr;
+            bestLevel->totalQuantity = 0;
+            orderBook->removePriceFromBook(bestLevel);
+            bestLevel = is_buy ? orderBook->bestAskLevel : orderBook->bestBidLevel;
+            continue;
         }
-    }
 
-    size_t tradeCount = trades.size();
-    for (size_t i = 0; i < tradeCount; ++i)
-    {
-        Trade &trade = trades[i];
-        bool isLastTrade = (i == tradeCount - 1);
-
-        if (!isLastTrade)
+        // The incoming order runs out within this level, the level itself stays
+        Order *oppositeOrder = bestLevel->headOrder;
+        while (remainingQuantity > 0)
         {
-            // Before the last trades, all the status for opposite orders are SUCCESS
-            if (is_buy)
+            const int tradedQuantity = std::min(oppositeOrder->getQuantity(), remainingQuantity);
+            remainingQuantity -= tradedQuantity;
+
+            if (oppositeOrder->getQuantity() == tradedQuantity)
             {
-                trade.setSellOrderStatus(TradeStatus::SUCCESS);
-                trade.setBuyOrderStatus(TradeStatus::PARTIALLY_FILLED);
-            } else {
-                trade.setBuyOrderStatus(TradeStatus::SUCCESS);
-                trade.setSellOrderStatus(TradeStatus::PARTIALLY_FILLED);
+                emitFill(oppositeOrder, tradedPrice, tradedQuantity, 0);
+                orderBook->orderIdToOrder.erase(oppositeOrder->getId());
+                Order *nextOrder = oppositeOrder->next;
+                orderBook->removeOrderFromBook(oppositeOrder);
+                orderPool.release(oppositeOrder);
+                oppositeOrder = nextOrder;
             }
-        } else
-        {
-            // For the last trade, check if the opposite order is in orderIdToOrderNode
-            // If yes, then the order is success and opposite order is PARTIALLY_FILLED
-            if (is_buy)
+            else
             {
-                const bool oppositeOrderInMap = orderBook->orderIdToOrderNode.find(trade.getSellOrderId()) != orderBook->orderIdToOrderNode.end();
-                trade.setSellOrderStatus(oppositeOrderInMap ? TradeStatus::PARTIALLY_FILLED : TradeStatus::SUCCESS);
-                trade.setBuyOrderStatus(remainingQuantity != 0 ? TradeStatus::PARTIALLY_FILLED : TradeStatus::SUCCESS);
-            } else {
-                const bool oppositeOrderInMap = orderBook->orderIdToOrderNode.find(trade.getBuyOrderId()) != orderBook->orderIdToOrderNode.end();
-                trade.setBuyOrderStatus(oppositeOrderInMap ? TradeStatus::PARTIALLY_FILLED : TradeStatus::SUCCESS);
-                trade.setSellOrderStatus(remainingQuantity != 0 ? TradeStatus::PARTIALLY_FILLED : TradeStatus::SUCCESS);
+                bestLevel->totalQuantity -= tradedQuantity;
+                oppositeOrder->fill(tradedQuantity);
+                emitFill(oppositeOrder, tradedPrice, tradedQuantity, oppositeOrder->getQuantity());
             }
         }
     }
 
-    order->setQuantity(remainingQuantity);
-
-    if (!trades.empty()) {
-        instrumentToTradedPrice[instrument] = trades.back().getPrice();
+    if (remainingQuantity != order->getQuantity())
+    {
+        order->fill(order->getQuantity() - remainingQuantity);
     }
-    return trades;
 }
 
-auto MatchingEngine::getOrderBook(const std::string &instrument) -> OrderBook*
+void MatchingEngine::emitTrade(const Trade &trade, ExecutionSink &sink)
+{
+    tradeHistory.record(trade);
+    sink.onTrade(trade);
+}
+
+auto MatchingEngine::getOrderBook(const InstrumentId instrument) -> OrderBook*
 {
-    std::unique_lock lock(orderBooksMutex);
-    const auto iter = orderBooks.find(instrument);
-    return (iter != orderBooks.end()) ? iter->second : nullptr;
+    return (instrument < orderBooks.size()) ? orderBooks[instrument].load(std::memory_order_acquire) : nullptr;
 }
 
 
@@ -0,0 +1,150 @@
+#include <stdexcept>
+#include "OccupancyBitmap.h"
+
+namespace
+{
+    constexpr std::size_t WORD_BITS = 64;
+    constexpr std::size_t WORD_SHIFT = 6;
+    constexpr std::size_t WORD_MASK = WORD_BITS - 1;
+
+    // Bits strictly above position b
+    inline std::uint64_t maskAbove(const std::size_t b)
+    {
+        return (b == WORD_MASK) ? 0 : (~0ULL << (b + 1));
+    }
+
+    // Bits at or above position b
+    inline std::uint64_t maskFrom(const std::size_t b)
+    {
+        return ~0ULL << b;
+    }
+
+    // Bits strictly below position b
+    inline std::uint64_t maskBelow(const std::size_t b)
+    {
+        return (1ULL << b) - 1;
+    }
+
+    // Bits at or below position b
+    inline std::uint64_t maskUpTo(const std::size_t b)
+    {
+        return (b == WORD_MASK) ? ~0ULL : ((1ULL << (b + 1)) - 1);
+    }
+
+    inline std::size_t lowestBit(const std::uint64_t word)
+    {
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+    }
+
+    inline std::size_t highestBit(const std::uint64_t word)
+    {
+        return WORD_MASK - static_cast<std::size_t>(__builtin_clzll(word));
+    }
+}
+
+OccupancyBitmap::OccupancyBitmap(const std::size_t size) : bitCount(size)
+{
+    if (size == 0 || size > MAX_SIZE)
+    {
+        throw std::invalid_argument("OccupancyBitmap size must be between 1 and 262144.");
+    }
+    const std::size_t leafWords = (size + WORD_MASK) >> WORD_SHIFT;
+    leaves.assign(leafWords, 0);
+    mid.assign((leafWords + WORD_MASK) >> WORD_SHIFT, 0);
+}
+
+void OccupancyBitmap::set(const std::size_t index)
+{
+    const std::size_t leafIndex = index >> WORD_SHIFT;
+    const std::size_t midIndex = leafIndex >> WORD_SHIFT;
+    leaves[leafIndex] |= 1ULL << (index & WORD_MASK);
+    mid[midIndex] |= 1ULL << (leafIndex & WORD_MASK);
+    top |= 1ULL << midIndex;
+}
+
+void OccupancyBitmap::clear(const std::size_t index)
+{
+    const std::size_t leafIndex = index >> WORD_SHIFT;
+    const std::size_t midIndex = leafIndex >> WORD_SHIFT;
+    leaves[leafIndex] &= ~(1ULL << (index & WORD_MASK));
+    if (leaves[leafIndex] == 0)
+    {
+        mid[midIndex] &= ~(1ULL << (leafIndex & WORD_MASK));
+        if (mid[midIndex] == 0)
+        {
+            top &= ~(1ULL << midIndex);
+        }
+    }
+}
+
+bool OccupancyBitmap::test(const std::size_t index) const
+{
+    return (leaves[index >> WORD_SHIFT] >> (index & WORD_MASK)) & 1ULL;
+}
+
+bool OccupancyBitmap::any() const
+{
+    return top != 0;
+}
+
+std::size_t OccupancyBitmap::findNext(const std::size_t from) const
+{
+    if (from >= bitCount)
+    {
+        return npos;
+    }
+
+    const std::size_t leafIndex = from >> WORD_SHIFT;
+    if (const std::uint64_t bits = leaves[leafIndex] & maskFrom(from & WORD_MASK); bits != 0)
+    {
+        return (leafIndex << WORD_SHIFT) | lowestBit(bits);
+    }
+
+    const std::size_t midIndex = leafIndex >> WORD_SHIFT;
+    if (const std::uint64_t bits = mid[midIndex] & maskAbove(leafIndex & WORD_MASK); bits != 0)
+    {
+        const std::size_t nextLeaf = (midIndex << WORD_SHIFT) | lowestBit(bits);
+        return (nextLeaf << WORD_SHIFT) | lowestBit(leaves[nextLeaf]);
+    }
+
+    const std::uint64_t bits = top & maskAbove(midIndex);
+    return (bits != 0) ? lowestIn(lowestBit(bits)) : npos;
+}
+
+std::size_t OccupancyBitmap::findPrev(const std::size_t from) const
+{
+    const std::size_t start = (from >= bitCount) ? bitCount - 1 : from;
+
+    const std::size_t leafIndex = start >> WORD_SHIFT;
+    if (const std::uint64_t bits = leaves[leafIndex] & maskUpTo(start & WORD_MASK); bits != 0)
+    {
+        return (leafIndex << WORD_SHIFT) | highestBit(bits);
+    }
+
+    const std::size_t midIndex = leafIndex >> WORD_SHIFT;
+    if (const std::uint64_t bits = mid[midIndex] & maskBelow(leafIndex & WORD_MASK); bits != 0)
+    {
+        const std::size_t prevLeaf = (midIndex << WORD_SHIFT) | highestBit(bits);
+        return (prevLeaf << WORD_SHIFT) | highestBit(leaves[prevLeaf]);
+    }
+
+    const std::uint64_t bits = top & maskBelow(midIndex);
+    return (bits != 0) ? highestIn(highestBit(bits)) : npos;
+}
+
+std::size_t OccupancyBitmap::size() const
+{
+    return bitCount;
+}
+
+std::size_t OccupancyBitmap::lowestIn(const std::size_t midIndex) const
+{
+    const std::size_t leafIndex = (midIndex << WORD_SHIFT) | lowestBit(mid[midIndex]);
+    return (leafIndex << WORD_SHIFT) | lowestBit(leaves[leafIndex]);
+}
+
+std::size_t OccupancyBitmap::highestIn(const std::size_t midIndex) const
+{
+    const std::size_t leafIndex = (midIndex << WORD_SHIFT) | highestBit(mid[midIndex]);
+    return (leafIndex << WORD_SHIFT) | highestBit(leaves[leafIndex]);
+}
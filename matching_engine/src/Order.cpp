@@ -3,15 +3,14 @@
 #include "OrderType.h"
 #include "Order.h"
 
-Order::Order(const unsigned int id, std::string asset, const double price, const int quantity, const bool is_buy, const OrderType type)
-    : id(id), asset(std::move(asset)), price(price), quantity(quantity), is_buy(is_buy), type(type),
-      timestamp(currentTimestamp())
-{
-    if (price > 0.0)
-    {
-        this->price = price;
-    }
-    else if (type != OrderType::MARKET)
+Order::Order(const unsigned int id, const InstrumentId instrument, const Price price, const int quantity, const bool is_buy, const OrderType type, const Timestamp timestamp)
+    : id(id), quantity(quantity), is_buy(is_buy), type(type)
+{
+    OrderDetails &cold = details();
+    cold.price = price;
+    cold.instrument = instrument;
+    cold.timestamp = timestamp != 0 ? timestamp : monotonicNow();
+    if (price <= 0 && type != OrderType::MARKET)
     {
         throw std::invalid_argument("Price must be greater than zero.");
     }
@@ -26,11 +25,11 @@ Order::Order(const unsigned int id, std::string asset, const double price, const
     }
 }
 
-void Order::setPrice(const double new_price)
+void Order::setPrice(const Price new_price)
 {
-    if (new_price > 0.0)
+    if (new_price > 0)
     {
-        price = new_price;
+        details().price = new_price;
     }
     else
     {
@@ -51,9 +50,18 @@ void Order::setQuantity(const int new_quantity)
     quantity = new_quantity;
 }
 
-auto Order::getPrice() const -> double
+void Order::fill(const int filled_quantity)
 {
-    return price;
+    if (filled_quantity <= 0 || filled_quantity > quantity)
+    {
+        throw std::invalid_argument("Filled quantity must be positive and not exceed the open quantity.");
+    }
+    quantity -= filled_quantity;
+}
+
+auto Order::getPrice() const -> Price
+{
+    return details().price;
 }
 
 auto Order::getQuantity() const -> int
@@ -66,9 +74,9 @@ unsigned int Order::getId() const
     return id;
 }
 
-std::string Order::getAsset() const
+InstrumentId Order::getInstrument() const
 {
-    return asset;
+    return details().instrument;
 }
 
 bool Order::isBuy() const
@@ -81,22 +89,34 @@ OrderType Order::getType() const
     return type;
 }
 
-auto Order::getTimestamp() const -> std::chrono::system_clock::time_point
+auto Order::getTimestamp() const -> Timestamp
+{
+    return details().timestamp;
+}
+
+auto Order::details() -> OrderDetails &
 {
-    return timestamp;
+    return OrderSlab::cold(this);
+}
+
+auto Order::details() const -> const OrderDetails &
+{
+    return OrderSlab::cold(this);
 }
 
 void Order::displayOrderInfo() const
 {
+    const auto &[price, timestamp, instrument] = details();
     std::cout << "Order ID: " << id << "\n";
-    std::cout << "Asset: " << asset << "\n";
-    std::cout << "Price: " << price << "\n";
+    const InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    std::cout << "Asset: " << registry.getSymbol(instrument) << "\n";
+    std::cout << "Price: " << registry.toDouble(instrument, price) << " (" << price << " ticks)\n";
     std::cout << "Quantity: " << quantity << "\n";
     std::cout << "Type: " << (type == OrderType::LIMIT ? "LIMIT" : type == OrderType::MARKET ? "MARKET"
                                                                                              : "STOP")
               << "\n";
     std::cout << "Direction: " << (is_buy ? "Buy" : "Sell") << "\n";
-    std::cout << "Timestamp: " << timestampToString(timestamp)
+    std::cout << "Timestamp: " << timestampToString(toWallClock(timestamp))
               << " \n";
 }
 
@@ -105,7 +125,7 @@ auto Order::operator==(const Order &other) const -> bool
     /*
         This method only compare the price between two orders.
     */
-    bool flag = (this->price == other.price);
+    bool flag = (getPrice() == other.getPrice());
     return flag;
 }
 
@@ -114,21 +134,6 @@ auto Order::operator<(const Order &other) const -> bool
     /*
         This method only compare the price between two orders.
     */
-    bool flag = (this->price < other.price);
+    bool flag = (getPrice() < other.getPrice());
     return flag;
 }
-
-Order* Order::CreateMarketOrder(const unsigned int id, const std::string &asset, const int quantity, const bool is_buy)
-{
-    return new Order(id, asset, -1.0, quantity, is_buy, OrderType::MARKET);
-}
-
-Order* Order::CreateLimitOrder(const unsigned int id, const std::string &asset, const double price, const int quantity, const bool is_buy)
-{
-    return new Order(id, asset, price, quantity, is_buy, OrderType::LIMIT);
-}
-
-Order* Order::CreateStopOrder(const unsigned int id, const std::string &asset, const double price, const int quantity, const bool is_buy)
-{
-    return new Order(id, asset, price, quantity, is_buy, OrderType::STOP);
-}
\ No newline at end of file
@@ -1,41 +1,18 @@
 #include <utility>
 #include <iostream>
-#include <limits>
 #include "OrderBook.h"
 #include "Order.h"
+#include "matching_engine_config.hpp"
 
-double POS_INF = std::numeric_limits<double>::infinity();
-double NEG_INF = -std::numeric_limits<double>::infinity();
 
-
-OrderBook::OrderBook(std::string instrument) : instrument(std::move(instrument)), bestBidLevel(nullptr), bestAskLevel(nullptr)
+OrderBook::OrderBook(const InstrumentId instrument, const double tickSize, OrderPool &orderPool,
+                     const std::size_t expectedOrders)
+    : instrument(instrument), tickSize(tickSize), orderPool(orderPool), bestBidLevel(nullptr), bestAskLevel(nullptr),
+      bidLadder(matchingSystemConfig::orderBook::PRICE_LADDER_WINDOW, matchingSystemConfig::orderBook::PRICE_LADDER_HEADROOM, true),
+      askLadder(matchingSystemConfig::orderBook::PRICE_LADDER_WINDOW, matchingSystemConfig::orderBook::PRICE_LADDER_HEADROOM, false),
+      orderIdToOrder(expectedOrders),
+      priceLevelPool(matchingSystemConfig::orderBook::PRICE_LEVEL_CHUNK_SIZE)
 {
-
-    try {
-        constexpr int preallocatePriceLevelSize = 1000;
-        constexpr int preallocateOrderNodeSize = 10000;
-        for (size_t i = 0; i < preallocateOrderNodeSize; i++)
-        {
-            emptyOrderNodeStack.push(new OrderNode());
-        }
-        for (size_t i = 0; i < preallocatePriceLevelSize; i++)
-        {
-            emptyPriceLevelStack.push(new PriceLevel());
-        }
-    } catch(const std::bad_alloc& e) {
-        std::cerr << "Memory allocation failed: " << e.what() << '\n';
-        while (!emptyOrderNodeStack.empty()) {
-            delete emptyOrderNodeStack.top();
-            emptyOrderNodeStack.pop();
-        }
-        while (!emptyPriceLevelStack.empty()) {
-            delete emptyPriceLevelStack.top();
-            emptyPriceLevelStack.pop();
-        }
-        throw; // Continue to throw an error
-    }
-
-    // Initializes timer or other resources for cleanup
 }
 
 void OrderBook::setCrossCallback(CrossCallback callback) {
@@ -44,54 +21,35 @@ void OrderBook::setCrossCallback(CrossCallback callback) {
 
 OrderBook::~OrderBook()
 {
-    // release all the OrderNode and PriceLevel in the buySide
-    for (auto &pair : priceToPriceLevel)
+    // Return the resting orders to the order pool, the levels themselves are freed with their pool
+    for (const PriceLadder<PriceLevel> *ladder : {&bidLadder, &askLadder})
     {
-        PriceLevel *level = pair.second;
-
-        OrderNode *currentNode = level->headOrder;
-        while (currentNode != nullptr)
+        for (const PriceLevel *level = ladder->best(); level != nullptr; level = ladder->findWorse(level->price))
         {
-            OrderNode *nextNode = currentNode->next;
-            delete currentNode->order;
-            delete currentNode;
-            currentNode = nextNode;
+            Order *currentOrder = level->headOrder;
+            while (currentOrder != nullptr)
+            {
+                Order *nextOrder = currentOrder->next;
+                orderPool.release(currentOrder);
+                currentOrder = nextOrder;
+            }
         }
-
-        delete level;
-    }
-
-    // Release nullptr in emptyOrderNodeStack
-    while (!emptyOrderNodeStack.empty())
-    {
-        delete emptyOrderNodeStack.top();
-        emptyOrderNodeStack.pop();
-    }
-
-    // Release nullptr in emptyPriceStack
-    while (!emptyPriceLevelStack.empty())
-    {
-        delete emptyPriceLevelStack.top();
-        emptyPriceLevelStack.pop();
     }
 }
 
 void OrderBook::cancelLimitOrder(unsigned int orderId)
 {
-    // Look up the order node associated with the given order ID
-    auto it = orderIdToOrderNode.find(orderId);
-    if (it == orderIdToOrderNode.end())
+    // Look up the order associated with the given order ID
+    Order *order = orderIdToOrder.find(orderId);
+    if (order == nullptr)
     {
         std::cerr << "Order ID " << orderId << " not found.\n";
         return; // If the order is not found, return immediately
     }
 
-    OrderNode *orderNode = it->second; // Get the pointer to the order node
-    Order *order = orderNode->order;
-
-    removeOrderNodeFromBook(orderNode);
-    delete order;
-    orderIdToOrderNode.erase(it);
+    removeOrderFromBook(order);
+    orderPool.release(order);
+    orderIdToOrder.erase(orderId);
 }
 
 void OrderBook::cancelStopOrder(unsigned int orderId)
@@ -99,19 +57,16 @@ void OrderBook::cancelStopOrder(unsigned int orderId)
     // TODO: Cancel StopOrder logic
 }
 
-void OrderBook::modifyLimitOrder(unsigned int orderId, double newPrice, int newQuantity)
+void OrderBook::modifyLimitOrder(unsigned int orderId, Price newPrice, int newQuantity)
 {
-    auto it = orderIdToOrderNode.find(orderId);
-    if (it == orderIdToOrderNode.end()){
-        // If orderId does not exist in orderIdToOrderNode, return
+    Order* order = orderIdToOrder.find(orderId);
+    if (order == nullptr){
+        // If orderId does not exist in orderIdToOrder, return
         std::cerr << "OrderId " << orderId << " does not exist";
         return;
     }
 
-    OrderNode* orderNode = it->second;
-    Order* order = orderNode->order;
-
-    if ((newPrice <= 0.0) || (newQuantity < 0)){
+    if ((newPrice <= 0) || (newQuantity < 0)){
         // Input validation
         throw std::invalid_argument("Invalid input, newPrice and newQuantity must be greater than 0.");
     } else if (newQuantity == 0){
@@ -123,28 +78,27 @@ void OrderBook::modifyLimitOrder(unsigned int orderId, double newPrice, int newQ
     
     if (newPrice == order->getPrice()){
        // If the price is unchanged, just update the quantity of the order and the priceLevel
-        double oldPrice = order->getPrice();
+        Price oldPrice = order->getPrice();
         int oldQuantity = order->getQuantity();
     
         order->setQuantity(newQuantity);
-        PriceLevel* priceLevel = priceToPriceLevel[oldPrice];
+        PriceLevel* priceLevel = getLadder(order->isBuy() ? Side::BUY : Side::SELL).find(oldPrice);
         priceLevel->totalQuantity += (newQuantity - oldQuantity);
         return;
     }
 
     // Price is changed, we cancel the original order and create a new one
-    std::string asset =  order->getAsset();
+    InstrumentId instrument = order->getInstrument();
     bool isBuy = order->isBuy();
     cancelLimitOrder(orderId);
-    Order *newOrder = Order::CreateLimitOrder(orderId, asset, newPrice, newQuantity, isBuy);
+    Order *newOrder = orderPool.createLimitOrder(orderId, instrument, newPrice, newQuantity, isBuy);
     if (crossCallback) 
     { 
-        std::cout << "this is a call back" << std::endl;
         crossCallback(newOrder);
     }
 }
 
-void OrderBook::modifyStopOrder(unsigned int orderId, double newPrice, int newQuantity)
+void OrderBook::modifyStopOrder(unsigned int orderId, Price newPrice, int newQuantity)
 {
     // TODO: Modify StopOrder Logic
 }
@@ -155,7 +109,7 @@ Order *OrderBook::getBestBid() const
     {
         return nullptr;
     }
-    return bestBidLevel->headOrder->order;
+    return bestBidLevel->headOrder;
 }
 
 Order *OrderBook::getBestAsk() const
@@ -164,7 +118,12 @@ Order *OrderBook::getBestAsk() const
     {
         return nullptr;
     }
-    return bestAskLevel->headOrder->order;
+    return bestAskLevel->headOrder;
+}
+
+double OrderBook::getTickSize() const
+{
+    return tickSize;
 }
 
 void OrderBook::printOrderBook() const
@@ -176,7 +135,7 @@ void OrderBook::printOrderBook() const
     const PriceLevel* askLevel = bestAskLevel;
     while (askLevel != nullptr) {
         printPriceLevel(askLevel, 1);
-        askLevel = askLevel -> nextPrice;
+        askLevel = askLadder.findWorse(askLevel->price);
     }
 
     // Print all the bid levels, from high to low;
@@ -187,15 +146,15 @@ void OrderBook::printOrderBook() const
     const PriceLevel* bidLevel = bestBidLevel;
     while (bidLevel != nullptr) {
         printPriceLevel(bidLevel, 1);
-        bidLevel = bidLevel -> nextPrice;
+        bidLevel = bidLadder.findWorse(bidLevel->price);
     }
 
     std::cout << "----------------------------\n";
 }
 
-void OrderBook::printOrderBook(double minPrice, double maxPrice) const
+void OrderBook::printOrderBook(Price minPrice, Price maxPrice) const
 {
-    std::cout << "----- Order Book for " << instrument << " from " << minPrice << " to " << maxPrice << " ------\n";
+    std::cout << "----- Order Book for " << instrument << " from " << minPrice * tickSize << " to " << maxPrice * tickSize << " ------\n";
 
     std::cout << "Asks:\n";
     const PriceLevel* askLevel = bestAskLevel;
@@ -203,7 +162,7 @@ void OrderBook::printOrderBook(double minPrice, double maxPrice) const
         if (askLevel->price >= minPrice && askLevel->price <= maxPrice) {
             printPriceLevel(askLevel, 1);
         }
-        askLevel = askLevel -> nextPrice;
+        askLevel = askLadder.findWorse(askLevel->price);
     }
 
     std::cout << "----------------------------\n";
@@ -215,7 +174,7 @@ void OrderBook::printOrderBook(double minPrice, double maxPrice) const
         if (bidLevel->price >= minPrice && bidLevel->price <= maxPrice) {
             printPriceLevel(bidLevel, 1);
         }
-        bidLevel = bidLevel -> nextPrice;
+        bidLevel = bidLadder.findWorse(bidLevel->price);
     }
     
     std::cout << "----------------------------\n";
@@ -230,7 +189,7 @@ void OrderBook::printOrderBook(int depth) const
     const PriceLevel* askLevel = bestAskLevel;
     while ((askLevel != nullptr) && (currentAskDepth <= depth)) {
         printPriceLevel(askLevel, 1);
-        askLevel = askLevel -> nextPrice;
+        askLevel = askLadder.findWorse(askLevel->price);
         ++currentAskDepth;
     }
 
@@ -242,70 +201,43 @@ void OrderBook::printOrderBook(int depth) const
     const PriceLevel* bidLevel = bestBidLevel;
     while ((bidLevel != nullptr) && (currentBidDepth <= depth)) {
         printPriceLevel(bidLevel, 1);
-        bidLevel = bidLevel -> nextPrice;
+        bidLevel = bidLadder.findWorse(bidLevel->price);
         ++currentBidDepth;
     }
 
     std::cout << "----------------------------\n";
 }
 
-void OrderBook::addPriceLevel(PriceLevel *priceLevel, PriceLevel *&bestLevel) // NOLINT(*-convert-member-functions-to-static)
+void OrderBook::addPriceLevel(PriceLevel *priceLevel, PriceLevel *&bestLevel)
 {
-    PriceLevel *prevPrice = nullptr;
-    PriceLevel *nextPrice = bestLevel;
+    getLadder(priceLevel->side).insert(priceLevel->price, priceLevel);
 
-    bool isBuy = (priceLevel->side) == Side::BUY;
-
-    // This while loop is to find the appropriate prePrice and nextPrice for our new priceLevel
-    while ((nextPrice != nullptr) && ((isBuy && nextPrice->price > priceLevel->price) ||
-                                    (!isBuy && nextPrice->price < priceLevel->price)))
+    // Neighbouring levels are found through the ladder, only a new best level changes the BBO
+    const bool isBuy = priceLevel->side == Side::BUY;
+    if ((bestLevel == nullptr) || (isBuy && priceLevel->price > bestLevel->price) ||
+        (!isBuy && priceLevel->price < bestLevel->price))
     {
-        prevPrice = nextPrice;
-        nextPrice = nextPrice->nextPrice;
-    }
-
-    priceLevel->nextPrice = nextPrice;
-    priceLevel->prevPrice = prevPrice;
-    
-    if (prevPrice == nullptr)
-    {
-        // The new priceLevel get inserted at the beginning of the chain
         bestLevel = priceLevel;
     }
-    else
-    {
-        prevPrice->nextPrice = priceLevel;
-    }
-
-    if (nextPrice != nullptr)
-    {
-        // The new priceLevel get inserted at the ending of the chain
-        nextPrice->prevPrice = priceLevel;
-    }
-
 }
 
 void OrderBook::addLimitOrderToBook(Order *order)
 {
-    // Get a orderNode for the incoming order
-    OrderNode *orderNode = getOrderNode();
-    orderNode->order = order;
-
-    // Add to the orderIdToOrderNode
-    orderIdToOrderNode[order->getId()] = orderNode;
+    // Add to the orderIdToOrder
+    orderIdToOrder.insert(order->getId(), order);
 
     // Get the priceLevel
-    double price = order->getPrice();
-    auto it = priceToPriceLevel.find(price);
+    Price price = order->getPrice();
+    const Side side = order->isBuy() ? Side::BUY : Side::SELL;
+    PriceLevel *priceLevel = getLadder(side).find(price);
 
-    if (it != priceToPriceLevel.end())
+    if (priceLevel != nullptr)
     {   
-        // Add the OrderNode to the book
-        PriceLevel *priceLevel = it->second;
-        OrderNode *tailNode = priceLevel->tailOrder;
-        tailNode->next = orderNode;
-        orderNode->prev = tailNode;
-        priceLevel->tailOrder = orderNode;
+        // Append the order to the level's queue
+        Order *tailOrder = priceLevel->tailOrder;
+        tailOrder->next = order;
+        order->prev = tailOrder;
+        priceLevel->tailOrder = order;
 
         // Update totalQuantity of the priceLevel
         priceLevel->totalQuantity += order->getQuantity();
@@ -314,23 +246,14 @@ void OrderBook::addLimitOrderToBook(Order *order)
     {
         // If the priceLevel for the incoming node does not exist.
         
-        PriceLevel *priceLevel = getPriceLevel();
+        priceLevel = getPriceLevel();
         priceLevel->price = price;
         priceLevel->totalQuantity = order->getQuantity();
-        priceLevel->headOrder = orderNode;
-        priceLevel->tailOrder = orderNode;
-        priceToPriceLevel[price] = priceLevel;
+        priceLevel->headOrder = order;
+        priceLevel->tailOrder = order;
+        priceLevel->side = side;
 
-        if (order->isBuy())
-        {
-            priceLevel->side = Side::BUY;
-            addPriceLevel(priceLevel, bestBidLevel);
-        } 
-        else
-        {
-            priceLevel->side = Side::SELL;
-            addPriceLevel(priceLevel, bestAskLevel);
-        }
+        addPriceLevel(priceLevel, side == Side::BUY ? bestBidLevel : bestAskLevel);
     }
 }
 
@@ -339,42 +262,35 @@ void OrderBook::addStopOrderToBook(Order *order)
     // Add a new StopOrder Logic 
 }
 
-void OrderBook::removeOrderNodeFromBook(OrderNode *orderNode)
+void OrderBook::removeOrderFromBook(Order *order)
 {
     // Get the price of the order
-    double price = orderNode->order->getPrice();
-    PriceLevel *priceLevel = priceToPriceLevel[price];
+    Price price = order->getPrice();
+    PriceLevel *priceLevel = getLadder(order->isBuy() ? Side::BUY : Side::SELL).find(price);
 
-    // Remove the order node from the price level's linked list
-    if (orderNode->prev)
+    // Unlink the order from the price level's queue
+    if (order->prev)
     {
-        orderNode->prev->next = orderNode->next;
+        order->prev->next = order->next;
     }
     else
     {
-        // If it is the head node of the price level
-        if (orderNode->next)
-        {
-            priceLevel->headOrder = orderNode->next; // Update the head pointer
-        }
-        else
-        {
-            priceLevel->headOrder = nullptr; // If there are no other orders, clear the head pointer
-        }
+        // If it is the head order of the price level, or nullptr if there are no other orders
+        priceLevel->headOrder = order->next;
     }
 
-    if (orderNode->next)
+    if (order->next)
     {
-        orderNode->next->prev = orderNode->prev;
+        order->next->prev = order->prev;
     }
     else
     {
-        // If it is the tail node of the price level
-        priceLevel->tailOrder = orderNode->prev;
+        // If it is the tail order of the price level
+        priceLevel->tailOrder = order->prev;
     }
 
     // Update Level Quantity
-    priceLevel->totalQuantity -= orderNode->order->getQuantity();
+    priceLevel->totalQuantity -= order->getQuantity();
 
     if (priceLevel->totalQuantity == 0)
     {
@@ -385,7 +301,8 @@ void OrderBook::removeOrderNodeFromBook(OrderNode *orderNode)
         throw std::logic_error("totalQuantity is lower than 0 after removing the order form book");
     }
 
-    releaseOrderNode(orderNode);
+    order->prev = nullptr;
+    order->next = nullptr;
 }
 
 void OrderBook::removePriceFromBook(PriceLevel *priceLevel)
@@ -401,41 +318,22 @@ void OrderBook::removePriceFromBook(PriceLevel *priceLevel)
         throw std::logic_error("Can not remove a priceLevel where TotalQuantity is not zero");
     }
 
-    // Remove from the price level map
-    auto it = priceToPriceLevel.find(priceLevel->price);
-    if (it != priceToPriceLevel.end() && it->second == priceLevel)
+    // Remove from the price ladder
+    PriceLadder<PriceLevel> &ladder = getLadder(priceLevel->side);
+    if (ladder.find(priceLevel->price) == priceLevel)
     {
-        priceToPriceLevel.erase(it);
+        ladder.erase(priceLevel->price);
     }
 
-    // Remove from the doubly linked list
-    if (priceLevel->prevPrice)
+    // If the best level is removed, the occupancy bitmap gives the next best level directly.
+    // If this is the only level in that side of the book, it will set the bestLevel to a nullptr
+    if (priceLevel == bestBidLevel)
     {
-        priceLevel->prevPrice->nextPrice = priceLevel->nextPrice;
+        bestBidLevel = bidLadder.best();
     }
-    else
-    {
-        // If it's the head of the list
-        if (priceLevel->side == Side::BUY)
-        // If this is the only level in that side of the book, it will set the bestLevel to a nullptr
-        {   
-            bestBidLevel = priceLevel->nextPrice;
-        }
-        else
-        {
-            bestAskLevel = priceLevel->nextPrice;
-        }
-    }
-
-    if (priceLevel->nextPrice)
-    {
-        priceLevel->nextPrice->prevPrice = priceLevel->prevPrice;
-    }
-    else
+    else if (priceLevel == bestAskLevel)
     {
-        // No update required for nextPrice's prevPrice since this is the last price level.
-        // If this price level is the only one on its side of the order book,
-        // the Best Bid or Best Ask is set to nullptr when handling prevPrice.
+        bestAskLevel = askLadder.best();
     }
 
     releasePriceLevel(priceLevel);
@@ -443,113 +341,33 @@ void OrderBook::removePriceFromBook(PriceLevel *priceLevel)
 
 void OrderBook::updateBestPrices()
 {
-    std::cout << "This method will iterate through all the priceLevels in the book, " 
-          << "which is highly resource-intensive." << std::endl;
-    
-    auto it = priceToPriceLevel.begin();
-    double bestBidPrice = NEG_INF;
-    double bestAskPrice = POS_INF;
-    while (it != priceToPriceLevel.end())
-    {   
-        PriceLevel *priceLevel = it->second;
-        if (priceLevel->side == Side::BUY) 
-        {
-            if (priceLevel->price > bestBidPrice)
-            {
-                bestBidPrice = priceLevel->price;
-                bestBidLevel = priceLevel;
-            }
-        } else
-        {
-            if (priceLevel->price < bestAskPrice)
-            {
-                bestAskPrice = priceLevel->price;
-                bestAskLevel = priceLevel;
-            }
-        }
-        ++it;
-    }
+    bestBidLevel = bidLadder.best();
+    bestAskLevel = askLadder.best();
 }
 
-OrderBook::OrderNode *OrderBook::getOrderNode()
-{   
-    if (emptyOrderNodeStack.empty()) 
-    {
-        for (size_t i = 0; i < 2000; i++)
-        {
-            emptyOrderNodeStack.push(new OrderNode());
-        }
-    }
-    OrderNode *emptyOrderNode = emptyOrderNodeStack.top();
-    emptyOrderNodeStack.pop();
-    return emptyOrderNode;
+PriceLadder<OrderBook::PriceLevel> &OrderBook::getLadder(const Side side)
+{
+    return (side == Side::BUY) ? bidLadder : askLadder;
 }
 
-void OrderBook::releaseOrderNode(OrderNode *node)
+const PriceLadder<OrderBook::PriceLevel> &OrderBook::getLadder(const Side side) const
 {
-    // This function will not delete any order.
-    // It will only manage memory orderNode
-    node->next = nullptr;
-    node->prev = nullptr;
-    node->order = nullptr;
-    emptyOrderNodeStack.push(node);
+    return (side == Side::BUY) ? bidLadder : askLadder;
 }
 
 OrderBook::PriceLevel *OrderBook::getPriceLevel()
 {
-    if (emptyPriceLevelStack.empty()) 
-    {
-        for (size_t i = 0; i < 200; i++)
-        {
-            emptyPriceLevelStack.push(new PriceLevel());
-        }
-    }
-    PriceLevel *emptyPriceLevel = emptyPriceLevelStack.top();
-    emptyPriceLevelStack.pop();
-    return emptyPriceLevel;
+    return priceLevelPool.acquire();
 }
 
 void OrderBook::releasePriceLevel(PriceLevel *level)
 {
-    level->price = -1;
-    level->totalQuantity = -1;
-    level->side = Side::UNDEFINED;
-    level->headOrder = nullptr;
-    level->tailOrder = nullptr;
-    level->nextPrice = nullptr;
-    level->prevPrice = nullptr;
-    emptyPriceLevelStack.push(level);
+    priceLevelPool.release(level);
 }
 
-void OrderBook::cleanup()
+const SlabPoolStats &OrderBook::getPriceLevelStats() const
 {
-    constexpr int minOrderNodeSize = 5000;
-    constexpr int maxOrderNodeSize = 20000;
-    constexpr int minPriceLevelSize = 1000;
-    constexpr int maxPriceLevelSize = 2000;
-
-    while(emptyOrderNodeStack.size() < minOrderNodeSize) {
-        emptyOrderNodeStack.push(new OrderNode);
-    }
-
-    while (emptyOrderNodeStack.size() > maxOrderNodeSize)
-    {
-        delete emptyOrderNodeStack.top();
-        emptyOrderNodeStack.pop();
-    }
-
-    while (emptyPriceLevelStack.size() < minPriceLevelSize) 
-    {
-        emptyPriceLevelStack.push(new PriceLevel);
-    }
-
-    while (emptyPriceLevelStack.size() > maxPriceLevelSize)
-    {
-        delete emptyPriceLevelStack.top();
-        emptyPriceLevelStack.pop();
-    }
-    
-
+    return priceLevelPool.getStats();
 }
 
 void OrderBook::printPriceLevel(const PriceLevel *start, int depth) const// NOLINT(*-convert-member-functions-to-static)
@@ -559,19 +377,18 @@ void OrderBook::printPriceLevel(const PriceLevel *start, int depth) const// NOLI
     int printedLevels = 0;
 
     while (currentLevel != nullptr && printedLevels < depth) {
-        std::cout << "Price Level: " << currentLevel->price << "\n";
+        std::cout << "Price Level: " << currentLevel->price * tickSize << " (" << currentLevel->price << " ticks)\n";
         std::cout << "Total Quantity: " << currentLevel->totalQuantity << "\n";
         std::cout << "Orders at this level:\n";
 
-        OrderNode* currentOrderNode = currentLevel -> headOrder;
-        while (currentOrderNode != nullptr) {
-            Order* order = currentOrderNode->order;
+        const Order* order = currentLevel -> headOrder;
+        while (order != nullptr) {
             order->displayOrderInfo(); // display info of the node
-            currentOrderNode = currentOrderNode->next;
+            order = order->next;
         }
 
         // Move to the next priceLevel
-        currentLevel = currentLevel -> prevPrice;
+        currentLevel = getLadder(currentLevel->side).findWorse(currentLevel->price);
         printedLevels++;
     }
 
@@ -0,0 +1,128 @@
+#include "OrderIdIndex.h"
+
+namespace
+{
+    // 2^32 / golden ratio, consecutive IDs land far apart
+    constexpr std::uint32_t HASH_MULTIPLIER = 0x9E3779B1u;
+
+    constexpr auto log2(std::size_t value) -> unsigned int
+    {
+        unsigned int bits = 0;
+        while (value > 1)
+        {
+            value >>= 1;
+            ++bits;
+        }
+        return bits;
+    }
+
+    // Smallest power of two keeping the load factor of expectedOrders at or below one half
+    auto tableSize(const std::size_t expectedOrders) -> std::size_t
+    {
+        std::size_t size = OrderIdIndex::MIN_CAPACITY;
+        while (size < 2 * expectedOrders)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+}
+
+OrderIdIndex::OrderIdIndex(const std::size_t expectedOrders)
+    : slots(tableSize(expectedOrders), Slot{0, nullptr}), mask(slots.size() - 1), shift(32 - log2(slots.size()))
+{
+}
+
+auto OrderIdIndex::find(const unsigned int orderId) const -> Order *
+{
+    return slots[probe(orderId)].order;
+}
+
+auto OrderIdIndex::contains(const unsigned int orderId) const -> bool
+{
+    return find(orderId) != nullptr;
+}
+
+void OrderIdIndex::insert(const unsigned int orderId, Order *order)
+{
+    std::size_t index = probe(orderId);
+    if (slots[index].order == nullptr)
+    {
+        // Keep the load factor at or below one half
+        if (2 * (orderCount + 1) > slots.size())
+        {
+            grow();
+            index = probe(orderId);
+        }
+        ++orderCount;
+    }
+    slots[index] = Slot{orderId, order};
+}
+
+auto OrderIdIndex::erase(const unsigned int orderId) -> bool
+{
+    std::size_t hole = probe(orderId);
+    if (slots[hole].order == nullptr)
+    {
+        return false;
+    }
+
+    // Move back every following entry whose probe sequence passes through the hole
+    for (std::size_t next = (hole + 1) & mask; slots[next].order != nullptr; next = (next + 1) & mask)
+    {
+        const std::size_t wanted = home(slots[next].orderId);
+        if (((next - wanted) & mask) >= ((next - hole) & mask))
+        {
+            slots[hole] = slots[next];
+            hole = next;
+        }
+    }
+    slots[hole] = Slot{0, nullptr};
+    --orderCount;
+    return true;
+}
+
+auto OrderIdIndex::size() const -> std::size_t
+{
+    return orderCount;
+}
+
+auto OrderIdIndex::empty() const -> bool
+{
+    return orderCount == 0;
+}
+
+auto OrderIdIndex::capacity() const -> std::size_t
+{
+    return slots.size();
+}
+
+auto OrderIdIndex::home(const unsigned int orderId) const -> std::size_t
+{
+    return static_cast<std::uint32_t>(orderId * HASH_MULTIPLIER) >> shift;
+}
+
+auto OrderIdIndex::probe(const unsigned int orderId) const -> std::size_t
+{
+    std::size_t index = home(orderId);
+    while (slots[index].order != nullptr && slots[index].orderId != orderId)
+    {
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+void OrderIdIndex::grow()
+{
+    std::vector<Slot> old(2 * slots.size(), Slot{0, nullptr});
+    old.swap(slots);
+    mask = slots.size() - 1;
+    --shift;
+    for (const Slot &slot : old)
+    {
+        if (slot.order != nullptr)
+        {
+            slots[probe(slot.orderId)] = slot;
+        }
+    }
+}
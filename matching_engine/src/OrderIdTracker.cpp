@@ -0,0 +1,84 @@
+#include <stdexcept>
+#include "OrderIdTracker.h"
+
+namespace
+{
+    constexpr std::size_t WORD_SHIFT = 6;
+    constexpr std::size_t WORD_MASK = 63;
+
+    std::size_t wordsFor(const std::size_t windowSize)
+    {
+        std::size_t words = 1;
+        while ((words << WORD_SHIFT) < windowSize)
+        {
+            words <<= 1;
+        }
+        return words;
+    }
+}
+
+OrderIdTracker::OrderIdTracker(const std::size_t windowSize)
+{
+    if (windowSize == 0)
+    {
+        throw std::invalid_argument("OrderIdTracker window must hold at least one ID.");
+    }
+    ring.assign(wordsFor(windowSize), 0);
+    wordMask = ring.size() - 1;
+}
+
+void OrderIdTracker::insert(const unsigned int orderId)
+{
+    const std::uint64_t word = orderId >> WORD_SHIFT;
+    if (word < baseWord)
+    {
+        return; // Below the window, already counted as seen
+    }
+
+    if (const std::uint64_t windowEnd = baseWord + ring.size(); word >= windowEnd)
+    {
+        // Slide the window up to the new ID, clearing the words it leaves behind for reuse
+        const std::uint64_t newBase = word - ring.size() + 1;
+        const std::uint64_t clearEnd = newBase < windowEnd ? newBase : windowEnd;
+        for (std::uint64_t w = baseWord; w < clearEnd; ++w)
+        {
+            ring[w & wordMask] = 0;
+        }
+        baseWord = newBase;
+    }
+
+    ring[word & wordMask] |= std::uint64_t{1} << (orderId & WORD_MASK);
+    if (orderId > highest)
+    {
+        highest = orderId;
+    }
+}
+
+auto OrderIdTracker::contains(const unsigned int orderId) const -> bool
+{
+    const std::uint64_t word = orderId >> WORD_SHIFT;
+    if (word < baseWord)
+    {
+        return true;
+    }
+    if (word >= baseWord + ring.size())
+    {
+        return false;
+    }
+    return ((ring[word & wordMask] >> (orderId & WORD_MASK)) & 1U) != 0;
+}
+
+auto OrderIdTracker::highWaterMark() const -> unsigned int
+{
+    return highest;
+}
+
+auto OrderIdTracker::windowStart() const -> unsigned int
+{
+    return static_cast<unsigned int>(baseWord << WORD_SHIFT);
+}
+
+auto OrderIdTracker::footprintBytes() const -> std::size_t
+{
+    return ring.size() * sizeof(std::uint64_t);
+}
@@ -1,21 +1,41 @@
+#include <algorithm>
 #include <thread>
 #include <atomic>
 #include <iostream>
 
+#include "EventLog.h"
 #include "MatchingEngine.h"
 #include "OrderManager.h"
 #include "matching_engine_config.hpp"
 #include "MessageQueue.h"
-#include "IDGenerator.hpp"
+#include "LatencyMonitor.h"
 #include "Logger.hpp"
+#include "OrderTracer.h"
 
-OrderManager::OrderManager(MatchingEngine* engine, MessageQueue& messageQueue, TCPGateway* gateway)
-    : matchingEngine(engine), messageQueue(messageQueue), gateway(gateway){}
+OrderManager::OrderManager(MatchingEngine* engine, MessageQueue& messageQueue, TCPGateway* gateway,
+                           const std::size_t batchSize, InputJournal* journal)
+    : matchingEngine(engine), messageQueue(messageQueue), gateway(gateway), batchSize(batchSize == 0 ? 1 : batchSize),
+      journal(journal)
+{
+    pendingAcks.reserve(this->batchSize);
+    if (journal != nullptr && journal->getPolicy() == JournalSyncPolicy::GROUP_COMMIT) {
+        journal->setDurableCallback([this](const std::uint64_t durableCount) { releaseDurableAcks(durableCount); });
+    }
+}
+
+OrderManager::~OrderManager()
+{
+    if (journal != nullptr && journal->getPolicy() == JournalSyncPolicy::GROUP_COMMIT) {
+        // The journal outlives the manager, its syncer must not call back into it
+        journal->setDurableCallback({});
+    }
+}
 
 void OrderManager::start()
 {
     if (!managerRunning) {
         managerRunning = true;
+        EventLog::getInstance().start();
         messageProcessingThread = std::thread(&OrderManager::processLoop, this);
     } else {
         std::cout << "OrderManager already running" << '\n';
@@ -29,6 +49,11 @@ void OrderManager::stop()
         if (messageProcessingThread.joinable()) {
             messageProcessingThread.join();
         }
+        if (journal != nullptr) {
+            // Sends the acks still held back while the gateway is around
+            journal->sync();
+        }
+        EventLog::getInstance().stop();
     } else {
         Logger::getLogger(matchingSystemConfig::orderManager::LOGGER_NAME)->error("OrderManager is not running" );
     }
@@ -36,45 +61,172 @@ void OrderManager::stop()
 
 void OrderManager::processLoop()
 {
+    std::vector<Message> batch;
+    batch.reserve(batchSize);
+    batching = true;
     while (managerRunning)
     {
-        const auto logger = Logger::getLogger(matchingSystemConfig::orderManager::LOGGER_NAME);
-        if (Message msg; messageQueue.pop(msg))
-        {
-            switch (msg.type)
-            {
-            case MessageType::ADD_ORDER:
-                handleAddMessage(msg);
-                logger->info(msg.addOrderDetails->toString());
-                break;
-            case MessageType::MODIFY_ORDER:
-                handleModifyMessage(msg);
-                logger->info(msg.modifyDetails->toString());
-                break;
-            case MessageType::CANCEL_ORDER:
-                handleCancelMessage(msg);
-                logger->info(msg.cancelDetails->toString());
-                break;
-            default:
-                std::cerr << "Unknown Message Type." << '\n';
-                break;
-            }
-        } else {
-            // If messageQueue.pop(), suggesting that the queue is already closed.
+        if (messageQueue.popBatch(batch, batchSize) == 0) {
+            // If messageQueue.popBatch() returns nothing, suggesting that the queue is already closed.
             break;
         }
+        LatencyMonitor &monitor = LatencyMonitor::getInstance();
+        OrderTracer &tracer = OrderTracer::getInstance();
+        for (const Message &msg : batch) {
+            const std::uint64_t startTicks = LatencyMonitor::now();
+            monitor.record(LatencyStage::QUEUE_WAIT, msg.timestamp, startTicks);
+            tracer.record(msg.traceId, TraceStage::DEQUEUE);
+            processMessage(msg);
+            monitor.record(LatencyStage::MATCH, startTicks, LatencyMonitor::now());
+        }
+        flushBatch();
+        processedCount.fetch_add(batch.size(), std::memory_order_release);
     }
+    batching = false;
     if (!messageQueue.empty()){
         std::cerr << messageQueue.size() << " messages are in queue not processed.\n";
     }
 }
 
+void OrderManager::processMessage(const Message &message)
+{
+    switch (message.type)
+    {
+    case MessageType::ADD_ORDER:
+        // Journaled once it has its order ID
+        handleAddMessage(message);
+        break;
+    case MessageType::MODIFY_ORDER:
+        if (journal != nullptr) {
+            journal->append(message);
+        }
+        handleModifyMessage(message);
+        break;
+    case MessageType::CANCEL_ORDER:
+        if (journal != nullptr) {
+            journal->append(message);
+        }
+        handleCancelMessage(message);
+        break;
+    default:
+        std::cerr << "Unknown Message Type." << '\n';
+        return;
+    }
+    EventLog::getInstance().logMessage(message);
+}
+
+void OrderManager::acknowledge(const Message &message, std::string response)
+{
+    if (gateway == nullptr) {
+        return;
+    }
+    pendingAcks.push_back({message.client_id, std::move(response), message.timestamp, LatencyMonitor::now(), message.traceId});
+    if (!batching) {
+        flushBatch();
+    }
+}
+
+void OrderManager::flushBatch()
+{
+    logNewTrades();
+    if (journal == nullptr) {
+        if (gateway != nullptr) {
+            gateway->queueMessagesToSend(pendingAcks);
+        }
+        pendingAcks.clear();
+        return;
+    }
+    if (gateway == nullptr || journal->getPolicy() != JournalSyncPolicy::GROUP_COMMIT) {
+        journal->commit();
+        if (gateway != nullptr) {
+            gateway->queueMessagesToSend(pendingAcks);
+        }
+        pendingAcks.clear();
+        return;
+    }
+    // Committing under the lock keeps the syncer from releasing before the batch is held; the lock only ever
+    // guards a few moves, the syncer sends outside it
+    {
+        std::lock_guard<std::mutex> lock(heldAcksMutex);
+        const std::uint64_t sequence = journal->commit();
+        if (pendingAcks.empty()) {
+            return;
+        }
+        heldAcks.emplace_back(sequence, std::move(pendingAcks));
+        pendingAcks.clear();
+        if (!spareAckBuffers.empty()) {
+            pendingAcks.swap(spareAckBuffers.back());
+            spareAckBuffers.pop_back();
+        }
+    }
+    pendingAcks.reserve(batchSize);
+}
+
+void OrderManager::releaseDurableAcks(const std::uint64_t durableCount)
+{
+    std::vector<std::vector<TCPGateway::OutgoingMessage>> ready;
+    {
+        std::lock_guard<std::mutex> lock(heldAcksMutex);
+        while (!heldAcks.empty() && heldAcks.front().first <= durableCount) {
+            ready.push_back(std::move(heldAcks.front().second));
+            heldAcks.pop_front();
+        }
+    }
+    if (ready.empty()) {
+        return;
+    }
+    for (std::vector<TCPGateway::OutgoingMessage> &acks : ready) {
+        gateway->queueMessagesToSend(acks);
+    }
+    // The emptied buffers go back to the matching thread, which then does not allocate a new one per batch
+    std::lock_guard<std::mutex> lock(heldAcksMutex);
+    for (std::vector<TCPGateway::OutgoingMessage> &acks : ready) {
+        spareAckBuffers.push_back(std::move(acks));
+    }
+}
+
+void OrderManager::logNewTrades()
+{
+    // The engine only records fills, they are handed to the event log once per batch
+    const TradeHistory &history = matchingEngine->getTradeHistory();
+    const std::size_t total = history.totalCount();
+    if (total == loggedTradeCount) {
+        return;
+    }
+    EventLog &eventLog = EventLog::getInstance();
+    const std::size_t firstRecent = total - history.recentCount();
+    if (loggedTradeCount < firstRecent) {
+        // More trades in one batch than the ring keeps: the older ones are read back from the trade log
+        if (const TradeLog *log = history.getLog(); log != nullptr) {
+            // The log may start with trades of earlier runs, or with this batch's if it just rolled over
+            std::size_t first = loggedTradeCount;
+            if (log->size() < total - first) {
+                first = std::min(total - log->size(), firstRecent);
+                Logger::getLogger(matchingSystemConfig::mathingEngine::LOGGER_NAME)->warn(
+                    "{} trades are only in the trade log file rolled over from", first - loggedTradeCount);
+            }
+            const std::size_t base = log->size() - total;
+            for (std::size_t i = first; i < firstRecent; ++i) {
+                eventLog.logTrade(log->at(base + i));
+            }
+        } else {
+            Logger::getLogger(matchingSystemConfig::mathingEngine::LOGGER_NAME)->warn(
+                "{} trades left the trade history before they could be logged", firstRecent - loggedTradeCount);
+        }
+        loggedTradeCount = firstRecent;
+    }
+    for (std::size_t i = loggedTradeCount - firstRecent; i < history.recentCount(); ++i) {
+        eventLog.logTrade(history.recent(i));
+    }
+    loggedTradeCount = total;
+}
+
 void OrderManager::handleAddMessage(const Message &message)
 {
     const AddOrderDetails &details = *message.addOrderDetails;
-    const unsigned int newID = IDGenerator::getInstance().getNextOrderID();
+    const unsigned int newID = matchingEngine->getIDGenerator().getNextOrderID();
 
-    if (const std::string instrument = details.instrument; !matchingEngine->hasInstrument(instrument))
+    if (!matchingEngine->hasInstrument(details.instrument))
         {
         throw std::invalid_argument("Unknown Instrument.");
         }
@@ -83,14 +235,17 @@ void OrderManager::handleAddMessage(const Message &message)
         throw std::invalid_argument("Repeated order ID detected.");
     }
 
-    Order *newOrder = createOrder(details, newID);
-    matchingEngine->processNewOrder(newOrder);
+    if (journal != nullptr) {
+        journal->append(message, newID);
+    }
 
-    const std::string response = "Order added successfully with ID: " + std::to_string(newID);
+    Order *newOrder = createOrder(details, newID, message.timestamp);
+    OrderTracer &tracer = OrderTracer::getInstance();
+    tracer.record(message.traceId, TraceStage::MATCH_BEGIN);
+    matchingEngine->processNewOrder(newOrder, matchingEngine->getExecutionSink());
+    tracer.record(message.traceId, TraceStage::MATCH_END);
 
-    if (gateway != nullptr) {
-        gateway->queueMessageToSend(message.client_id, response);
-    }
+    acknowledge(message, "Order added successfully with ID: " + std::to_string(newID));
 
 }
 
@@ -98,16 +253,21 @@ auto OrderManager::isRunning() -> bool {
     return managerRunning;
 }
 
-auto OrderManager::createOrder(const AddOrderDetails& details, unsigned int orderID) -> Order * 
+auto OrderManager::getProcessedCount() const -> std::uint64_t {
+    return processedCount.load(std::memory_order_acquire);
+}
+
+auto OrderManager::createOrder(const AddOrderDetails& details, unsigned int orderID, const Timestamp timestamp) -> Order * 
 {
+    OrderPool &orderPool = matchingEngine->getOrderPool();
     switch (details.type)
     {
         case OrderType::MARKET:
-            return Order::CreateMarketOrder(orderID, details.instrument, details.quantity, details.isBuy);
+            return orderPool.createMarketOrder(orderID, details.instrument, details.quantity, details.isBuy, timestamp);
         case OrderType::LIMIT:
-            return Order::CreateLimitOrder(orderID, details.instrument, details.price, details.quantity, details.isBuy);
+            return orderPool.createLimitOrder(orderID, details.instrument, details.price, details.quantity, details.isBuy, timestamp);
         case OrderType::STOP:
-            return Order::CreateStopOrder(orderID, details.instrument, details.price, details.quantity, details.isBuy);
+            return orderPool.createStopOrder(orderID, details.instrument, details.price, details.quantity, details.isBuy, timestamp);
         default:
             throw std::invalid_argument("Unknown OrderType.");
     }
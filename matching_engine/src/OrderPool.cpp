@@ -0,0 +1,30 @@
+#include "OrderPool.h"
+
+OrderPool::OrderPool(const std::size_t initialChunks) : pool(initialChunks)
+{
+}
+
+auto OrderPool::createLimitOrder(const unsigned int id, const InstrumentId instrument, const Price price, const int quantity, const bool is_buy, const Timestamp timestamp) -> Order *
+{
+    return pool.acquire(id, instrument, price, quantity, is_buy, OrderType::LIMIT, timestamp);
+}
+
+auto OrderPool::createMarketOrder(const unsigned int id, const InstrumentId instrument, const int quantity, const bool is_buy, const Timestamp timestamp) -> Order *
+{
+    return pool.acquire(id, instrument, -1, quantity, is_buy, OrderType::MARKET, timestamp);
+}
+
+auto OrderPool::createStopOrder(const unsigned int id, const InstrumentId instrument, const Price price, const int quantity, const bool is_buy, const Timestamp timestamp) -> Order *
+{
+    return pool.acquire(id, instrument, price, quantity, is_buy, OrderType::STOP, timestamp);
+}
+
+void OrderPool::release(Order *order)
+{
+    pool.release(order);
+}
+
+auto OrderPool::getStats() const -> const SlabPoolStats &
+{
+    return pool.getStats();
+}
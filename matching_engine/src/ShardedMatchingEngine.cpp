@@ -0,0 +1,120 @@
+#include <stdexcept>
+#include "ShardedMatchingEngine.h"
+
+ShardedMatchingEngine::ShardedMatchingEngine(const std::size_t shardCount,
+                                             const MessageQueue::WaitStrategy waitStrategy,
+                                             const std::size_t queueCapacity,
+                                             const std::string &tradeLogPrefix,
+                                             const std::string &journalPrefix,
+                                             const JournalSyncPolicy journalPolicy)
+{
+    if (shardCount == 0) {
+        throw std::invalid_argument("ShardedMatchingEngine needs at least one shard.");
+    }
+    // The low bits of every order and trade ID name the shard, so no two shards share an ID counter
+    unsigned int shardBits = 0;
+    while ((std::size_t{1} << shardBits) < shardCount) {
+        ++shardBits;
+    }
+    shards.resize(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        Shard &shard = shards[i];
+        // Each shard queue is fed by one gateway thread only
+        shard.queue = std::make_unique<MessageQueue>(queueCapacity, MessageQueue::ProducerMode::SINGLE, waitStrategy);
+        shard.engine = std::make_unique<MatchingEngine>(
+            tradeLogPrefix.empty() ? std::string() : tradeLogPrefix + "_shard" + std::to_string(i) + ".bin",
+            static_cast<unsigned int>(i), shardBits);
+        if (!journalPrefix.empty()) {
+            shard.journal = std::make_unique<InputJournal>(journalPrefix + "_shard" + std::to_string(i) + ".journal",
+                                                           journalPolicy);
+        }
+    }
+}
+
+ShardedMatchingEngine::~ShardedMatchingEngine()
+{
+    stop();
+}
+
+auto ShardedMatchingEngine::createNewOrderBook(const std::string &instrument, const double tickSize,
+                                               const std::size_t expectedOrders) -> bool
+{
+    // The shard is picked by ID, but only the engine may set the tick size, after its own checks
+    InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    InstrumentId id = registry.find(instrument);
+    if (id == InstrumentRegistry::INVALID_ID) {
+        id = registry.registerInstrument(instrument, tickSize);
+    }
+    return getEngineFor(id).createNewOrderBook(instrument, tickSize, expectedOrders);
+}
+
+void ShardedMatchingEngine::start(TCPGateway* gateway)
+{
+    if (running) {
+        return;
+    }
+    for (Shard &shard : shards) {
+        shard.manager = std::make_unique<OrderManager>(shard.engine.get(), *shard.queue, gateway,
+                                                       matchingSystemConfig::orderManager::BATCH_SIZE,
+                                                       shard.journal.get());
+        shard.manager->start();
+    }
+    running = true;
+}
+
+void ShardedMatchingEngine::stop()
+{
+    if (!running) {
+        return;
+    }
+    for (Shard &shard : shards) {
+        shard.manager->stop();
+    }
+    running = false;
+}
+
+auto ShardedMatchingEngine::isRunning() const -> bool
+{
+    return running;
+}
+
+auto ShardedMatchingEngine::getRouter() const -> MessageRouter
+{
+    std::vector<MessageQueue *> queues;
+    queues.reserve(shards.size());
+    for (const Shard &shard : shards) {
+        queues.push_back(shard.queue.get());
+    }
+    return MessageRouter(std::move(queues));
+}
+
+auto ShardedMatchingEngine::getShardCount() const -> std::size_t
+{
+    return shards.size();
+}
+
+auto ShardedMatchingEngine::getShardIndex(const InstrumentId instrument) const -> std::size_t
+{
+    return MessageRouter::shardOf(instrument, shards.size());
+}
+
+auto ShardedMatchingEngine::getEngine(const std::size_t shard) -> MatchingEngine &
+{
+    return *shards.at(shard).engine;
+}
+
+auto ShardedMatchingEngine::getEngineFor(const InstrumentId instrument) -> MatchingEngine &
+{
+    return *shards[getShardIndex(instrument)].engine;
+}
+
+auto ShardedMatchingEngine::getProcessedCount() const -> std::uint64_t
+{
+    std::uint64_t total = 0;
+    for (const Shard &shard : shards) {
+        if (shard.manager) {
+            total += shard.manager->getProcessedCount();
+        }
+    }
+    return total;
+}
@@ -0,0 +1,67 @@
+#include <stdexcept>
+#include "TradeHistory.h"
+
+TradeHistory::TradeHistory(const std::size_t recentCapacity, const std::string &logPath) : capacity(recentCapacity)
+{
+    if (recentCapacity == 0)
+    {
+        throw std::invalid_argument("TradeHistory must keep at least one recent trade.");
+    }
+    ring.reserve(capacity);
+    if (!logPath.empty())
+    {
+        log = std::make_unique<TradeLog>(logPath);
+    }
+}
+
+void TradeHistory::record(const Trade &trade)
+{
+    if (ring.size() < capacity)
+    {
+        ring.push_back(trade);
+    }
+    else
+    {
+        ring[total % capacity] = trade;
+    }
+    ++total;
+
+    if (log)
+    {
+        log->append(trade);
+    }
+}
+
+auto TradeHistory::totalCount() const -> std::size_t
+{
+    return total;
+}
+
+auto TradeHistory::recentCount() const -> std::size_t
+{
+    return ring.size();
+}
+
+auto TradeHistory::recent(const std::size_t index) const -> const Trade &
+{
+    if (index >= ring.size())
+    {
+        throw std::out_of_range("Recent trade index out of range.");
+    }
+    // Once the ring is full, the oldest trade sits where the next one will be written
+    const std::size_t oldest = (ring.size() < capacity) ? 0 : total % capacity;
+    return ring[(oldest + index) % capacity];
+}
+
+auto TradeHistory::copyRecent() const -> std::vector<Trade>
+{
+    std::vector<Trade> trades;
+    trades.reserve(ring.size());
+    forEachRecent([&trades](const Trade &trade) { trades.push_back(trade); });
+    return trades;
+}
+
+auto TradeHistory::getLog() const -> const TradeLog *
+{
+    return log.get();
+}
@@ -1,14 +1,17 @@
 #include "SystemLauncher.h"
 #include <iostream>
+#include "LatencyMonitor.h"
 #include "Logger.hpp"
+#include "OrderTracer.h"
+#include "TimestampUtility.h"
 #include "config.hpp"
 
 using namespace systemLauncher;
 
 std::shared_ptr<spdlog::logger> SystemLauncher::logger = nullptr;
 
-SystemLauncher::SystemLauncher(std::string address, const int port)
-    : address_(std::move(address)), port_(port), async_stop_(), running_(false), stopSignal_(nullptr)
+SystemLauncher::SystemLauncher(std::string address, const int port, const MessageQueue::WaitStrategy waitStrategy)
+    : address_(std::move(address)), port_(port), waitStrategy_(waitStrategy), async_stop_(), running_(false), stopSignal_(nullptr)
 {
     logger = Logger::getLogger(LOGGER_NAME, true);
     logger->set_pattern(LOGGER_PATTERN); // 设置仅显示日志消息
@@ -30,14 +33,20 @@ SystemLauncher::~SystemLauncher()
 
 void SystemLauncher::run()
 {
-    messageQueue_ = std::make_unique<MessageQueue>();
-    engine_ = std::make_unique<MatchingEngine>();
-    gateway_ = std::make_shared<TCPGateway>(&loop_, *messageQueue_);
-    manager_ = std::make_unique<OrderManager>(engine_.get(), *messageQueue_, gateway_.get());
+    // Calibrate the clock here rather than on the first order the gateway stamps
+    monotonicNow();
+    logger->info(LOG_CLOCK_SOURCE, isTscClock() ? "the invariant TSC" : "CLOCK_MONOTONIC");
+
+    engine_ = std::make_unique<ShardedMatchingEngine>(matchingSystemConfig::shardedEngine::SHARD_COUNT, waitStrategy_,
+                                                      Utility_Config::MessageQueue::DEFAULT_CAPACITY,
+                                                      matchingSystemConfig::tradeHistory::LOG_FILE_PREFIX,
+                                                      matchingSystemConfig::journal::FILE_PREFIX,
+                                                      parseJournalSyncPolicy(matchingSystemConfig::journal::SYNC_POLICY));
+    gateway_ = std::make_shared<TCPGateway>(&loop_, engine_->getRouter());
 
     engine_->createNewOrderBook(DEFAULT_ORDERBOOK_INSTRUMENT);
 
-    manager_->start();
+    engine_->start(gateway_.get());
     gateway_->start(address_, port_);
     logger->info(LOG_EVENT_LOOP_STARTED);
 
@@ -49,7 +58,7 @@ void SystemLauncher::run()
 
     stopSignal_ = std::make_unique<StopSignal>();
     stopSignal_->gateway = gateway_;
-    stopSignal_->manager = manager_.get();
+    stopSignal_->engine = engine_.get();
     stopSignal_->loop = &loop_;
     async_stop_.data = stopSignal_.get();
 
@@ -80,8 +89,12 @@ void SystemLauncher::on_stop_signal(uv_async_t* handle)
     if (signal->gateway) {
         signal->gateway->stop();
     }
-    if (signal->manager != nullptr) {
-        signal->manager->stop();
+    if (signal->engine != nullptr) {
+        signal->engine->stop();
+    }
+    logger->info(LOG_LATENCY_REPORT, LatencyMonitor::getInstance().report());
+    if (OrderTracer::getInstance().getSampleInterval() != 0) {
+        dumpOrderTrace();
     }
 
     uv_stop(signal->loop);
@@ -94,6 +107,16 @@ void SystemLauncher::on_stop_signal(uv_async_t* handle)
 }
 
 
+void SystemLauncher::dumpOrderTrace()
+{
+    try {
+        const std::size_t events = OrderTracer::getInstance().dump(TRACE_FILE);
+        logger->info(LOG_TRACE_WRITTEN, events, TRACE_FILE);
+    } catch (const std::runtime_error& e) {
+        logger->error(LOG_TRACE_FAILED, e.what());
+    }
+}
+
 void SystemLauncher::stop()
 {
     if (running_) {
@@ -115,6 +138,16 @@ void SystemLauncher::registerCommands() {
         logger->info(CMD_HELP_MESSAGE);
     };
 
+    commandHandlers[LATENCY_COMMAND] = []() {
+        logger->info(LOG_COMMAND_RECEIVED, LATENCY_COMMAND);
+        logger->info(LOG_LATENCY_REPORT, LatencyMonitor::getInstance().report());
+    };
+
+    commandHandlers[TRACE_COMMAND] = []() {
+        logger->info(LOG_COMMAND_RECEIVED, TRACE_COMMAND);
+        dumpOrderTrace();
+    };
+
     commandHandlers["create_orderbook"] = [this]() {
         std::string newInstrument;
         logger->info(CMD_ENTER_INSTRUMENT);
@@ -8,19 +8,19 @@
 #include <uv.h>
 
 #include "MessageQueue.h"
-#include "MatchingEngine.h"
-#include "OrderManager.h"
+#include "ShardedMatchingEngine.h"
 #include "TCPGateway.h"
 
 struct StopSignal {
     std::shared_ptr<TCPGateway> gateway;
-    OrderManager* manager;
+    ShardedMatchingEngine* engine;
     uv_loop_t* loop;
 };
 
 class SystemLauncher {
 public:
-    SystemLauncher(std::string address, int port);
+    SystemLauncher(std::string address, int port,
+                   MessageQueue::WaitStrategy waitStrategy = MessageQueue::WaitStrategy::BLOCKING);
 
     ~SystemLauncher();
 
@@ -34,11 +34,14 @@ private:
 
 
     static void on_stop_signal(uv_async_t* handle);
+    // Writes the sampled order lifecycles to TRACE_FILE
+    static void dumpOrderTrace();
     void registerCommands();
     void inputLoop();
 
     std::string address_;
     int port_;
+    MessageQueue::WaitStrategy waitStrategy_;
 
     uv_loop_t loop_{};
     uv_async_t async_stop_{};
@@ -46,9 +49,7 @@ private:
     std::thread inputThread_;
     std::unordered_map<std::string, std::function<void()>> commandHandlers;
 
-    std::unique_ptr<MessageQueue> messageQueue_;
-    std::unique_ptr<MatchingEngine> engine_;
-    std::unique_ptr<OrderManager> manager_;
+    std::unique_ptr<ShardedMatchingEngine> engine_;
     std::shared_ptr<TCPGateway> gateway_;
 
     std::unique_ptr<StopSignal> stopSignal_;
@@ -4,6 +4,12 @@
 namespace mainConfig {
     constexpr auto ADDRESS = "127.0.0.1";
     constexpr unsigned int PORT = 7001;
+    // How the matching thread waits for messages, overridden by the first command line argument:
+    // busy_spin and spin_yield need a dedicated core, spin_park and blocking share it
+    constexpr auto WAIT_STRATEGY = "blocking";
+    // Trace one inbound order in this many through the OrderTracer, overridden by the second command line
+    // argument; 0 turns tracing off
+    constexpr unsigned int TRACE_SAMPLE_INTERVAL = 0;
 }
 
 namespace systemLauncher {
@@ -15,13 +21,20 @@ namespace systemLauncher {
     constexpr char STOP_COMMAND[] = "stop";
     constexpr char HELP_COMMAND[] = "help";
     constexpr char CREATE_ORDERBOOK_COMMAND[] = "create_orderbook";
+    constexpr char LATENCY_COMMAND[] = "latency";
+    constexpr char TRACE_COMMAND[] = "trace";
+
+    // Chrome trace / Perfetto JSON written by the trace command and on stop
+    constexpr auto TRACE_FILE = "order_trace.json";
 
     // Command Messages
     constexpr char CMD_HELP_MESSAGE[] =
         "Available commands:\n"
         "1. stop               - Stop the system.\n"
         "2. help               - Display this help message.\n"
-        "3. create_orderbook   - Create a new order book. You will be prompted to enter an instrument name.\n\n"
+        "3. create_orderbook   - Create a new order book. You will be prompted to enter an instrument name.\n"
+        "4. latency            - Show p50/p99/p99.9/max latency of each stage of the order path.\n"
+        "5. trace              - Write the sampled order lifecycles to order_trace.json (chrome://tracing, Perfetto).\n\n"
         "Usage:\n"
         "Type the command name and press Enter.";
 
@@ -41,6 +54,10 @@ namespace systemLauncher {
     constexpr char LOG_ASYNC_STOP_CLOSED[] = "async_stop_handle closed.";
     constexpr char LOG_INIT_ASYNC_FAILED[] = "Initialize async failed: {}";
     constexpr char LOG_COMMAND_RECEIVED[] = "Command '{}' received.";
+    constexpr char LOG_LATENCY_REPORT[] = "Order path latency:\n{}";
+    constexpr char LOG_CLOCK_SOURCE[] = "Timestamps taken from {}.";
+    constexpr char LOG_TRACE_WRITTEN[] = "{} order trace events written to {}.";
+    constexpr char LOG_TRACE_FAILED[] = "Order trace not written: {}";
 
     constexpr auto DEFAULT_ORDERBOOK_INSTRUMENT = "AAPL";
 }
@@ -1,13 +1,34 @@
+#include <iostream>
+#include "OrderTracer.h"
 #include "SystemLauncher.h"
 #include "config.hpp"
 
-int main() // NOLINT(*-use-trailing-return-type)
+int main(const int argc, char* argv[]) // NOLINT(*-use-trailing-return-type)
 {
     const std::string address = mainConfig::ADDRESS;
     constexpr int port = mainConfig::PORT;
 
-    SystemLauncher launcher(address, port);
+    MessageQueue::WaitStrategy waitStrategy;
+    try {
+        waitStrategy = MessageQueue::parseWaitStrategy(argc > 1 ? argv[1] : mainConfig::WAIT_STRATEGY);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    unsigned int traceSampleInterval = mainConfig::TRACE_SAMPLE_INTERVAL;
+    if (argc > 2) {
+        try {
+            traceSampleInterval = static_cast<unsigned int>(std::stoul(argv[2]));
+        } catch (const std::exception&) {
+            std::cerr << "Invalid trace sample interval: " << argv[2] << '\n';
+            return 1;
+        }
+    }
+    OrderTracer::getInstance().setSampleInterval(traceSampleInterval);
+
+    SystemLauncher launcher(address, port, waitStrategy);
     launcher.run();
 
     return 0;
-}
\ No newline at end of file
+}
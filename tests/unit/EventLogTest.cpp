@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include "EventLog.h"
+#include "InstrumentRegistry.hpp"
+#include "TimestampUtility.h"
+#include "TradeFormat.h"
+
+class EventLogTest : public ::testing::Test {
+protected:
+    InstrumentId instrument{};
+
+    void SetUp() override {
+        instrument = InstrumentRegistry::getInstance().registerInstrument("AAPL");
+    }
+};
+
+TEST_F(EventLogTest, RecordsFormatLikeTheOriginals) {
+    const Message add = Message::createAddOrderMessage(instrument, 15025, 100, true, OrderType::LIMIT);
+    const Message modify = Message::createModifyOrderMessage(7, instrument, 15100, 40);
+    const Message cancel = Message::createCancelOrderMessage(9, instrument);
+
+    Trade trade(3, 7, 9, instrument, 15025, 60, toWallClock(monotonicNow()));
+    trade.setBuyOrderStatus(TradeStatus::SUCCESS);
+    trade.setSellOrderStatus(TradeStatus::PARTIALLY_FILLED);
+    trade.setSellLeavesQuantity(40);
+
+    for (const std::string format : {"default", "json", "csv"}) {
+        EXPECT_EQ(EventLog::format(EventLog::fromMessage(add), format), add.addOrderDetails->toString(format));
+        EXPECT_EQ(EventLog::format(EventLog::fromMessage(modify), format), modify.modifyDetails->toString(format));
+        EXPECT_EQ(EventLog::format(EventLog::fromMessage(cancel), format), cancel.cancelDetails->toString(format));
+        EXPECT_EQ(EventLog::format(EventLog::fromTrade(trade), format), formatTrade(trade, format));
+    }
+}
+
+TEST_F(EventLogTest, FullRingDropsInsteadOfBlocking) {
+    EventLog &eventLog = EventLog::getInstance();
+    eventLog.drain();
+    const std::uint64_t droppedBefore = eventLog.droppedCount();
+
+    // A fresh thread gets a ring of its own, nobody drains it meanwhile
+    std::thread([this, &eventLog]() {
+        const Message cancel = Message::createCancelOrderMessage(1, instrument);
+        for (std::size_t i = 0; i < EventLog::RING_CAPACITY + 3; ++i) {
+            eventLog.logMessage(cancel);
+        }
+    }).join();
+
+    EXPECT_EQ(eventLog.droppedCount() - droppedBefore, 3);
+    EXPECT_EQ(eventLog.drain(), EventLog::RING_CAPACITY);
+    EXPECT_EQ(eventLog.drain(), 0);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "InputJournal.h"
+#include "InstrumentRegistry.hpp"
+
+class InputJournalTest : public ::testing::Test {
+protected:
+    InstrumentId instrument{};
+    std::string journalPath;
+
+    void SetUp() override {
+        instrument = InstrumentRegistry::getInstance().registerInstrument("AAPL");
+        journalPath = (std::filesystem::temp_directory_path() / "input_journal_test.journal").string();
+        removeFiles();
+    }
+
+    void TearDown() override {
+        removeFiles();
+    }
+
+    void removeFiles() const {
+        std::filesystem::remove(journalPath);
+        std::filesystem::remove(journalPath + ".old");
+        for (int n = 1; n <= 4; ++n) {
+            std::filesystem::remove(journalPath + ".old." + std::to_string(n));
+        }
+    }
+};
+
+TEST_F(InputJournalTest, CommittedRecordsCanBeReadBack) {
+    {
+        InputJournal journal(journalPath, JournalSyncPolicy::NONE, 2);
+        Message add = Message::createAddOrderMessage(instrument, 15025, 100, true, OrderType::LIMIT);
+        add.client_id = 3;
+        add.timestamp = 42;
+        journal.append(add, 7);
+        journal.append(Message::createModifyOrderMessage(7, instrument, 15100, 40));
+        journal.append(Message::createCancelOrderMessage(7, instrument));
+        EXPECT_EQ(journal.size(), 0);
+        EXPECT_EQ(journal.commit(), 3);
+        EXPECT_EQ(journal.at(2).sequence, 3);
+        EXPECT_THROW(static_cast<void>(journal.at(3)), std::out_of_range);
+
+        // Appended but never committed
+        journal.append(Message::createCancelOrderMessage(8, instrument));
+    }
+
+    const std::vector<JournalRecord> records = InputJournal::readRecords(journalPath);
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0].sequence, 1);
+    EXPECT_EQ(records[0].orderId, 7);
+    EXPECT_EQ(records[2].sequence, 3);
+
+    const Message add = InputJournal::toMessage(records[0]);
+    ASSERT_EQ(add.type, MessageType::ADD_ORDER);
+    EXPECT_EQ(add.client_id, 3);
+    EXPECT_EQ(add.timestamp, 42);
+    EXPECT_EQ(add.addOrderDetails->instrument, instrument);
+    EXPECT_EQ(add.addOrderDetails->price, 15025);
+    EXPECT_EQ(add.addOrderDetails->quantity, 100);
+    EXPECT_TRUE(add.addOrderDetails->isBuy);
+    EXPECT_EQ(add.addOrderDetails->type, OrderType::LIMIT);
+
+    const Message modify = InputJournal::toMessage(records[1]);
+    ASSERT_EQ(modify.type, MessageType::MODIFY_ORDER);
+    EXPECT_EQ(modify.modifyDetails->orderId, 7);
+    EXPECT_EQ(modify.modifyDetails->newPrice, 15100);
+    EXPECT_EQ(modify.modifyDetails->newQuantity, 40);
+}
+
+TEST_F(InputJournalTest, EveryRunStartsANewJournal) {
+    {
+        InputJournal journal(journalPath, JournalSyncPolicy::NONE);
+        journal.append(Message::createCancelOrderMessage(1, instrument));
+        journal.commit();
+    }
+
+    // Order IDs restart with the process, so the earlier run's journal is kept aside rather than continued
+    InputJournal journal(journalPath, JournalSyncPolicy::NONE);
+    EXPECT_EQ(journal.size(), 0);
+    journal.append(Message::createCancelOrderMessage(2, instrument));
+    EXPECT_EQ(journal.commit(), 1);
+    EXPECT_EQ(journal.at(0).sequence, 1);
+
+    const std::vector<JournalRecord> earlier = InputJournal::readRecords(journalPath + ".old");
+    ASSERT_EQ(earlier.size(), 1);
+    EXPECT_EQ(earlier[0].orderId, 1);
+}
+
+TEST_F(InputJournalTest, GroupCommitReportsDurableBatches) {
+    InputJournal journal(journalPath, JournalSyncPolicy::GROUP_COMMIT, 4);
+    std::atomic<std::uint64_t> reported{0};
+    journal.setDurableCallback([&reported](const std::uint64_t durableCount) { reported = durableCount; });
+
+    // Grows the file past its initial capacity on the way
+    for (unsigned int id = 1; id <= 100; ++id) {
+        journal.append(Message::createCancelOrderMessage(id, instrument));
+    }
+    journal.commit();
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (reported < 100 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(reported, 100);
+    EXPECT_EQ(journal.durableCount(), 100);
+    EXPECT_EQ(journal.at(99).orderId, 100);
+}
+
+TEST_F(InputJournalTest, FullReservationRollsOver) {
+    // One page of address space holds the header and perFile records
+    const auto reserved = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t perFile = (reserved - sizeof(LogFileHeader)) / sizeof(JournalRecord);
+    const auto total = static_cast<unsigned int>(2 * perFile + 7);
+    InputJournal journal(journalPath, JournalSyncPolicy::GROUP_COMMIT, 4, reserved);
+    for (unsigned int id = 1; id <= total; ++id) {
+        journal.append(Message::createCancelOrderMessage(id, instrument));
+        if (id % 10 == 0) {
+            journal.commit();
+        }
+    }
+    EXPECT_EQ(journal.commit(), total);
+    EXPECT_EQ(journal.size(), total);
+    EXPECT_EQ(journal.at(total - 1).sequence, total);
+    EXPECT_THROW(static_cast<void>(journal.at(0)), std::out_of_range);
+    journal.sync();
+    EXPECT_EQ(journal.durableCount(), total);
+
+    const std::vector<JournalRecord> first = InputJournal::readRecords(journalPath + ".old");
+    ASSERT_EQ(first.size(), perFile);
+    EXPECT_EQ(first[0].sequence, 1);
+    const std::vector<JournalRecord> second = InputJournal::readRecords(journalPath + ".old.1");
+    ASSERT_EQ(second.size(), perFile);
+    EXPECT_EQ(second[0].sequence, perFile + 1);
+    const std::vector<JournalRecord> current = InputJournal::readRecords(journalPath);
+    ASSERT_EQ(current.size(), 7);
+    EXPECT_EQ(current[0].orderId, 2 * perFile + 1);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "InstrumentRegistry.hpp"
+
+TEST(InstrumentRegistryTest, InternsSymbolsOnce)
+{
+    InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    const InstrumentId first = registry.registerInstrument("REGISTRY_A");
+    const InstrumentId second = registry.registerInstrument("REGISTRY_B");
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(registry.registerInstrument("REGISTRY_A"), first);
+    EXPECT_EQ(registry.find("REGISTRY_A"), first);
+    EXPECT_EQ(registry.resolve("REGISTRY_B"), second);
+    EXPECT_EQ(registry.getSymbol(second), "REGISTRY_B");
+    EXPECT_TRUE(registry.contains(second));
+}
+
+TEST(InstrumentRegistryTest, RejectsUnknownSymbolsAndIds)
+{
+    InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+
+    EXPECT_EQ(registry.find("UNREGISTERED"), InstrumentRegistry::INVALID_ID);
+    EXPECT_THROW((void)registry.resolve("UNREGISTERED"), std::invalid_argument);
+    EXPECT_FALSE(registry.contains(InstrumentRegistry::INVALID_ID));
+    EXPECT_THROW((void)registry.getSymbol(InstrumentRegistry::INVALID_ID), std::out_of_range);
+    EXPECT_THROW(registry.registerInstrument(""), std::invalid_argument);
+}
+
+TEST(InstrumentRegistryTest, ConvertsOnGridPrices)
+{
+    InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    const InstrumentId id = registry.registerInstrument("TICK_TEST", 0.05);
+
+    EXPECT_EQ(registry.toTicks(id, 150.25), 3005);
+    EXPECT_DOUBLE_EQ(registry.toDouble(id, 3005), 150.25);
+}
+
+TEST(InstrumentRegistryTest, RejectsOffGridPrices)
+{
+    InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    const InstrumentId id = registry.registerInstrument("TICK_TEST", 0.05);
+
+    EXPECT_THROW((void)registry.toTicks(id, 150.26), std::invalid_argument);
+    EXPECT_THROW(registry.registerInstrument("TICK_TEST", 0.0), std::invalid_argument);
+}
+
+TEST(InstrumentRegistryTest, DefaultTickSize)
+{
+    InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    const InstrumentId id = registry.registerInstrument("DEFAULT_TICK_TEST");
+
+    EXPECT_DOUBLE_EQ(registry.getTickSize(id), Utility_Config::Tick::DEFAULT_TICK_SIZE);
+    EXPECT_EQ(registry.toTicks(id, 1.23), 123);
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "LatencyMonitor.h"
+
+TEST(LatencyMonitorTest, BucketsKeepRelativePrecision)
+{
+    // Small values are exact
+    for (std::uint64_t value = 0; value < LatencyHistogram::SUB_BUCKET_COUNT * 2; ++value)
+    {
+        EXPECT_EQ(LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value)), value);
+    }
+    for (const std::uint64_t value : {100ULL, 12345ULL, 987654321ULL, 1ULL << 40, ~0ULL})
+    {
+        const std::uint64_t upper = LatencyHistogram::bucketUpperBound(LatencyHistogram::bucketIndex(value));
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value), static_cast<double>(value) / LatencyHistogram::SUB_BUCKET_COUNT);
+    }
+    EXPECT_EQ(LatencyHistogram::bucketIndex(~0ULL), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST(LatencyMonitorTest, PercentilesOfUniformValues)
+{
+    LatencyHistogram histogram;
+    for (std::uint64_t value = 1; value <= 10000; ++value)
+    {
+        histogram.record(value);
+    }
+    EXPECT_EQ(histogram.count(), 10000);
+    EXPECT_EQ(histogram.max(), 10000);
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(50.0)), 5000.0, 5000.0 / 32);
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(99.0)), 9900.0, 9900.0 / 32);
+    EXPECT_NEAR(static_cast<double>(histogram.valueAtPercentile(99.9)), 9990.0, 9990.0 / 32);
+    EXPECT_EQ(histogram.valueAtPercentile(100.0), 10000);
+}
+
+TEST(LatencyMonitorTest, MergesThreads)
+{
+    LatencyMonitor &monitor = LatencyMonitor::getInstance();
+    monitor.reset();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&monitor, t]() {
+            for (std::uint64_t i = 1; i <= 1000; ++i)
+            {
+                monitor.record(LatencyStage::MATCH, 1000, 1000 + i * (t + 1));
+            }
+            // Unstamped messages are not counted
+            monitor.record(LatencyStage::MATCH, 0, 500);
+        });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto histogram = monitor.merged(LatencyStage::MATCH);
+    EXPECT_EQ(histogram->count(), 4000);
+    EXPECT_EQ(histogram->max(), 4000);
+    EXPECT_EQ(monitor.summary(LatencyStage::MATCH).count, 4000);
+    EXPECT_EQ(monitor.summary(LatencyStage::ACK).count, 0);
+    EXPECT_NE(monitor.report().find("match"), std::string::npos);
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "LevelQueue.h"
+
+TEST(LevelQueueTest, MatchesInTimePriority)
+{
+    LevelQueue queue;
+    for (unsigned int id = 1; id <= 3; ++id)
+    {
+        queue.push(id, 10, nullptr);
+    }
+    EXPECT_EQ(queue.getTotalQuantity(), 30);
+
+    std::vector<std::pair<unsigned int, int>> fills;
+    const int filled = queue.match(25, [&](const LevelQueue::Entry &entry, const int traded) {
+        fills.emplace_back(entry.orderId, traded);
+    });
+
+    EXPECT_EQ(filled, 25);
+    ASSERT_EQ(fills.size(), 3);
+    EXPECT_EQ(fills[0], std::make_pair(1U, 10));
+    EXPECT_EQ(fills[2], std::make_pair(3U, 5));
+    EXPECT_EQ(queue.liveCount(), 1);
+    EXPECT_EQ(queue.front()->orderId, 3);
+    EXPECT_EQ(queue.front()->quantity, 5);
+    EXPECT_EQ(queue.getTotalQuantity(), 5);
+}
+
+TEST(LevelQueueTest, CancelledEntriesAreSkipped)
+{
+    LevelQueue queue;
+    const LevelQueue::Position first = queue.push(1, 10, nullptr);
+    const LevelQueue::Position second = queue.push(2, 10, nullptr);
+    queue.push(3, 10, nullptr);
+
+    queue.cancel(first);
+    queue.reduce(second, 4);
+    EXPECT_EQ(queue.tombstoneCount(), 1);
+    EXPECT_EQ(queue.getTotalQuantity(), 14);
+    EXPECT_THROW(queue.cancel(first), std::out_of_range);
+
+    std::vector<unsigned int> filledIds;
+    queue.match(100, [&](const LevelQueue::Entry &entry, int) { filledIds.push_back(entry.orderId); });
+    EXPECT_EQ(filledIds, (std::vector<unsigned int>{2, 3}));
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+TEST(LevelQueueTest, ReduceCannotIncrease)
+{
+    LevelQueue queue;
+    const LevelQueue::Position first = queue.push(1, 10, nullptr);
+    queue.push(2, 10, nullptr);
+
+    // More quantity would keep a place in the queue it did not earn
+    EXPECT_THROW(queue.reduce(first, 11), std::invalid_argument);
+    EXPECT_EQ(queue.at(first).quantity, 10);
+    EXPECT_EQ(queue.getTotalQuantity(), 20);
+
+    queue.reduce(first, 10);
+    EXPECT_EQ(queue.getTotalQuantity(), 20);
+    queue.reduce(first, 0);
+    EXPECT_EQ(queue.liveCount(), 1);
+    EXPECT_EQ(queue.front()->orderId, 2);
+}
+
+TEST(LevelQueueTest, CompactionReportsNewPositions)
+{
+    LevelQueue queue;
+    std::vector<LevelQueue::Position> positions;
+    for (unsigned int id = 0; id < 200; ++id)
+    {
+        positions.push_back(queue.push(id, 1, nullptr));
+    }
+    // Keep every fourth order
+    for (unsigned int id = 0; id < 200; ++id)
+    {
+        if (id % 4 != 0)
+        {
+            queue.cancel(positions[id]);
+        }
+    }
+    ASSERT_TRUE(queue.needsCompaction());
+
+    queue.compact([&](const LevelQueue::Entry &entry, const LevelQueue::Position position) {
+        positions[entry.orderId] = position;
+    });
+    EXPECT_EQ(queue.tombstoneCount(), 0);
+    EXPECT_EQ(queue.liveCount(), 50);
+    EXPECT_FALSE(queue.needsCompaction());
+
+    // Moved entries are still reachable through their reported positions
+    for (unsigned int id = 0; id < 200; id += 4)
+    {
+        EXPECT_EQ(queue.at(positions[id]).orderId, id);
+    }
+    queue.cancel(positions[4]);
+    EXPECT_EQ(queue.front()->orderId, 0);
+    EXPECT_EQ(queue.getTotalQuantity(), 49);
+}
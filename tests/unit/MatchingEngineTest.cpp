@@ -1,38 +1,43 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <iostream>
+#include <string>
+#include <thread>
 #include "Order.h"
 #include "MatchingEngine.h"
 #include "IDGenerator.hpp"
+#include "InstrumentRegistry.hpp"
+#include "TradeFormat.h"
 
 TEST(MatchingEngineTest, AddLimitOrder)
 {
     IDGenerator::getInstance().reset();
     MatchingEngine engine;
-    std::string instrument = "AAPL";
-    engine.createNewOrderBook(instrument);
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
 
     // Creates a limit buy order
     unsigned int buyOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *buyOrder = Order::CreateLimitOrder(buyOrderId, instrument, 150.0, 100, true);
+    Order *buyOrder = engine.getOrderPool().createLimitOrder(buyOrderId, instrument, 150, 100, true);
     std::vector<Trade> trades = engine.processNewOrder(buyOrder);
 
     EXPECT_TRUE(trades.empty());
 
     Order *bestBid = engine.getOrderBookForRead(instrument)->getBestBid();
     ASSERT_NE(bestBid, nullptr);
-    EXPECT_DOUBLE_EQ(bestBid->getPrice(), 150.0);
+    EXPECT_EQ(bestBid->getPrice(), 150);
 
     // Creats a limit sell order, which has price crossed with the best Bid
     unsigned int sellOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *sellOrder = Order::CreateLimitOrder(sellOrderId, instrument, 150.0, 120, false);
+    Order *sellOrder = engine.getOrderPool().createLimitOrder(sellOrderId, instrument, 150, 120, false);
     trades = engine.processNewOrder(sellOrder);
 
     // There should be a transaction
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].getBuyOrderId(), buyOrderId);
     EXPECT_EQ(trades[0].getSellOrderId(), sellOrderId);
-    EXPECT_EQ(trades[0].getAsset(), instrument);
-    EXPECT_DOUBLE_EQ(trades[0].getPrice(), 150.0);
+    EXPECT_EQ(trades[0].getInstrument(), instrument);
+    EXPECT_EQ(trades[0].getPrice(), 150);
     EXPECT_EQ(trades[0].getQuantity(), 100);
 
     // Current BBO should be empty
@@ -44,49 +49,49 @@ TEST(MatchingEngineTest, MultiOrderProcessing)
 {
     IDGenerator::getInstance().reset();
     MatchingEngine engine;
-    std::string instrument = "AAPL";
-    engine.createNewOrderBook(instrument);
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
 
     // Add Limit Order on Bid side
     unsigned int buyOrderId1 = IDGenerator::getInstance().getNextOrderID();
-    Order *buyOrder1 = Order::CreateLimitOrder(buyOrderId1, instrument, 150.0, 100, true);
+    Order *buyOrder1 = engine.getOrderPool().createLimitOrder(buyOrderId1, instrument, 150, 100, true);
     engine.processNewOrder(buyOrder1);
 
     unsigned int buyOrderId2 = IDGenerator::getInstance().getNextOrderID();
-    Order *buyOrder2 = Order::CreateLimitOrder(buyOrderId2, instrument, 155.0, 50, true);
+    Order *buyOrder2 = engine.getOrderPool().createLimitOrder(buyOrderId2, instrument, 155, 50, true);
     engine.processNewOrder(buyOrder2);
 
     Order *bestBid = engine.getOrderBookForRead(instrument)->getBestBid();
     ASSERT_NE(bestBid, nullptr);
-    EXPECT_DOUBLE_EQ(bestBid->getPrice(), 155.0);
+    EXPECT_EQ(bestBid->getPrice(), 155);
     EXPECT_EQ(bestBid->getQuantity(), 50);
 
     // Add Limit Order on Ask side
     unsigned int sellOrderId1 = IDGenerator::getInstance().getNextOrderID();
-    Order *sellOrder1 = Order::CreateLimitOrder(sellOrderId1, instrument, 152.0, 120, false);
+    Order *sellOrder1 = engine.getOrderPool().createLimitOrder(sellOrderId1, instrument, 152, 120, false);
     engine.processNewOrder(sellOrder1);
 
     unsigned int sellOrderId2 = IDGenerator::getInstance().getNextOrderID();
-    Order *sellOrder2 = Order::CreateLimitOrder(sellOrderId2, instrument, 160.0, 25, false);
+    Order *sellOrder2 = engine.getOrderPool().createLimitOrder(sellOrderId2, instrument, 160, 25, false);
     engine.processNewOrder(sellOrder2);
 
     std::vector<Trade> trades = engine.getTrades();
-    std::cout << trades[0].toString() << '\n';
+    std::cout << formatTrade(trades[0]) << '\n';
     
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].getBuyOrderId(), buyOrderId2);
-    EXPECT_DOUBLE_EQ(trades[0].getPrice(), 155.0);
+    EXPECT_EQ(trades[0].getPrice(), 155);
     EXPECT_EQ(trades[0].getQuantity(), 50);
 
     // Verify the BBO in the orderbook
     bestBid = engine.getOrderBookForRead(instrument)->getBestBid();
     ASSERT_NE(bestBid, nullptr);
-    EXPECT_DOUBLE_EQ(bestBid->getPrice(), 150.0);
+    EXPECT_EQ(bestBid->getPrice(), 150);
     EXPECT_EQ(bestBid->getQuantity(), 100);
     
     Order *bestAsk = engine.getOrderBookForRead(instrument)->getBestAsk();
     ASSERT_NE(bestAsk, nullptr);
-    EXPECT_DOUBLE_EQ(bestAsk->getPrice(), 152.0);
+    EXPECT_EQ(bestAsk->getPrice(), 152);
     EXPECT_EQ(bestAsk->getQuantity(), 70);
 
     engine.getOrderBookForRead(instrument)->printOrderBook();
@@ -96,20 +101,20 @@ TEST(MatchingEngineTest, ModifyOrder)
 {
     IDGenerator::getInstance().reset();
     MatchingEngine engine;
-    std::string instrument = "AAPL";
-    engine.createNewOrderBook(instrument);
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
 
     unsigned int buyOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *buyOrder = Order::CreateLimitOrder(buyOrderId, instrument, 150.0, 100, true);
+    Order *buyOrder = engine.getOrderPool().createLimitOrder(buyOrderId, instrument, 150, 100, true);
     engine.processNewOrder(buyOrder);
 
-    double newPrice = 155.0;
+    Price newPrice = 155;
     int newQuantity = 150;
     engine.modifyOrder(buyOrderId, instrument, newPrice, newQuantity);
 
     Order *bestBid = engine.getOrderBookForRead(instrument)->getBestBid();
     ASSERT_NE(bestBid, nullptr);
-    EXPECT_DOUBLE_EQ(bestBid->getPrice(), newPrice);
+    EXPECT_EQ(bestBid->getPrice(), newPrice);
     EXPECT_EQ(bestBid->getQuantity(), newQuantity);
 }
 
@@ -117,11 +122,11 @@ TEST(MatchingEngineTest, CancelOrder)
 {
     IDGenerator::getInstance().reset();
     MatchingEngine engine;
-    std::string instrument = "AAPL";
-    engine.createNewOrderBook(instrument);
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
 
     unsigned int sellOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *sellOrder = Order::CreateLimitOrder(sellOrderId, instrument, 160.0, 200, false);
+    Order *sellOrder = engine.getOrderPool().createLimitOrder(sellOrderId, instrument, 160, 200, false);
     engine.processNewOrder(sellOrder);
 
     engine.cancelOrder(sellOrderId, instrument);
@@ -137,35 +142,35 @@ TEST(MatchingEngineTest, MarketOrder)
 {
     IDGenerator::getInstance().reset();
     MatchingEngine engine;
-    std::string instrument = "AAPL";
-    engine.createNewOrderBook(instrument);
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
 
     unsigned int limitBuyOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *limitBuyOrder = Order::CreateLimitOrder(limitBuyOrderId, instrument, 150, 100, true);
+    Order *limitBuyOrder = engine.getOrderPool().createLimitOrder(limitBuyOrderId, instrument, 150, 100, true);
     engine.processNewOrder(limitBuyOrder);
 
     unsigned int limitSellOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *limitSellOrder = Order::CreateLimitOrder(limitSellOrderId, instrument, 155.0, 50, false);
+    Order *limitSellOrder = engine.getOrderPool().createLimitOrder(limitSellOrderId, instrument, 155, 50, false);
     engine.processNewOrder(limitSellOrder);
 
     unsigned int marketBuyOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *marketBuyOrder = Order::CreateMarketOrder(marketBuyOrderId, instrument, 60, true);
+    Order *marketBuyOrder = engine.getOrderPool().createMarketOrder(marketBuyOrderId, instrument, 60, true);
     std::vector<Trade> trades = engine.processNewOrder(marketBuyOrder);
 
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].getBuyOrderId(), marketBuyOrderId);
     EXPECT_EQ(trades[0].getSellOrderId(), limitSellOrderId);
-    EXPECT_DOUBLE_EQ(trades[0].getPrice(), 155.0);
+    EXPECT_EQ(trades[0].getPrice(), 155);
     EXPECT_EQ(trades[0].getQuantity(), 50);
 
     unsigned int marketSellOrderId = IDGenerator::getInstance().getNextOrderID();
-    Order *marketSellOrder = Order::CreateMarketOrder(marketSellOrderId, instrument, 80, false);
+    Order *marketSellOrder = engine.getOrderPool().createMarketOrder(marketSellOrderId, instrument, 80, false);
     trades = engine.processNewOrder(marketSellOrder);
 
     ASSERT_EQ(trades.size(), 1);
     EXPECT_EQ(trades[0].getBuyOrderId(), limitBuyOrderId);
     EXPECT_EQ(trades[0].getSellOrderId(), marketSellOrderId);
-    EXPECT_DOUBLE_EQ(trades[0].getPrice(), 150.0);
+    EXPECT_EQ(trades[0].getPrice(), 150);
     EXPECT_EQ(trades[0].getQuantity(), 80);
 
     Order *remainingLimitBuyOrder = engine.getOrderBookForRead(instrument)->getBestBid();
@@ -173,3 +178,195 @@ TEST(MatchingEngineTest, MarketOrder)
     EXPECT_EQ(remainingLimitBuyOrder->getQuantity(), 20);
 
 }
+
+TEST(MatchingEngineTest, FilledOrdersReturnToPool)
+{
+    IDGenerator::getInstance().reset();
+    MatchingEngine engine;
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
+
+    unsigned int buyOrderId = IDGenerator::getInstance().getNextOrderID();
+    engine.processNewOrder(engine.getOrderPool().createLimitOrder(buyOrderId, instrument, 150, 100, true));
+    EXPECT_EQ(engine.getOrderPool().getStats().inUse, 1);
+
+    // A limit order filled on arrival never rests, both sides go back to the pool
+    unsigned int sellOrderId = IDGenerator::getInstance().getNextOrderID();
+    std::vector<Trade> trades = engine.processNewOrder(engine.getOrderPool().createLimitOrder(sellOrderId, instrument, 150, 100, false));
+
+    ASSERT_EQ(trades.size(), 1);
+    EXPECT_EQ(trades[0].getBuyOrderStatus(), TradeStatus::SUCCESS);
+    EXPECT_EQ(trades[0].getSellOrderStatus(), TradeStatus::SUCCESS);
+    EXPECT_EQ(engine.getOrderBookForRead(instrument)->getBestBid(), nullptr);
+    EXPECT_EQ(engine.getOrderBookForRead(instrument)->getBestAsk(), nullptr);
+    EXPECT_EQ(engine.getOrderPool().getStats().inUse, 0);
+    EXPECT_EQ(engine.getOrderPool().getStats().releaseCount, 2);
+}
+
+TEST(MatchingEngineTest, SweepTakesWholeLevels)
+{
+    MatchingEngine engine;
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
+    OrderPool &pool = engine.getOrderPool();
+
+    // Three bids at 100 and two at 99
+    for (int i = 0; i < 5; ++i) {
+        engine.processNewOrder(pool.createLimitOrder(IDGenerator::getInstance().getNextOrderID(), instrument, i < 3 ? 100 : 99, 10, true));
+    }
+
+    // Clears the 100 level in one sweep and ends inside the 99 level
+    const unsigned int takerId = IDGenerator::getInstance().getNextOrderID();
+    std::vector<Trade> trades = engine.processNewOrder(pool.createMarketOrder(takerId, instrument, 35, false));
+
+    ASSERT_EQ(trades.size(), 4);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(trades[i].getPrice(), 100);
+        EXPECT_EQ(trades[i].getBuyOrderStatus(), TradeStatus::SUCCESS);
+        EXPECT_EQ(trades[i].getBuyLeavesQuantity(), 0);
+        EXPECT_EQ(trades[i].getSellLeavesQuantity(), 25 - 10 * i);
+    }
+    EXPECT_EQ(trades[3].getPrice(), 99);
+    EXPECT_EQ(trades[3].getQuantity(), 5);
+    EXPECT_EQ(trades[3].getBuyOrderStatus(), TradeStatus::PARTIALLY_FILLED);
+    EXPECT_EQ(trades[3].getBuyLeavesQuantity(), 5);
+    EXPECT_EQ(trades[3].getSellOrderStatus(), TradeStatus::SUCCESS);
+
+    const Order *bestBid = engine.getOrderBookForRead(instrument)->getBestBid();
+    ASSERT_NE(bestBid, nullptr);
+    EXPECT_EQ(bestBid->getPrice(), 99);
+    EXPECT_EQ(bestBid->getQuantity(), 5);
+    EXPECT_EQ(pool.getStats().inUse, 2);
+    EXPECT_EQ(engine.getLastTradePrice(instrument), 99);
+}
+
+TEST(MatchingEngineTest, RemoveAndRecreateOrderBook)
+{
+    MatchingEngine engine;
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
+
+    Order *bid = engine.getOrderPool().createLimitOrder(IDGenerator::getInstance().getNextOrderID(), instrument, 150, 100, true);
+    engine.processNewOrder(bid);
+    const OrderBook *removed = engine.getOrderBookForRead(instrument);
+
+    engine.removeOrderBook(instrument);
+    EXPECT_FALSE(engine.hasInstrument(instrument));
+    EXPECT_EQ(engine.getOrderBookForRead(instrument), nullptr);
+    // A pointer taken before the removal still reads a valid book
+    EXPECT_EQ(removed->getBestBid()->getPrice(), 150);
+
+    EXPECT_TRUE(engine.createNewOrderBook("AAPL"));
+    ASSERT_NE(engine.getOrderBookForRead(instrument), nullptr);
+    EXPECT_NE(engine.getOrderBookForRead(instrument), removed);
+    EXPECT_EQ(engine.getOrderBookForRead(instrument)->getBestBid(), nullptr);
+}
+
+TEST(MatchingEngineTest, OrdersForRemovedBookAreIgnored)
+{
+    MatchingEngine engine;
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
+    const unsigned int orderId = IDGenerator::getInstance().getNextOrderID();
+    engine.processNewOrder(engine.getOrderPool().createLimitOrder(orderId, instrument, 150, 100, true));
+    ASSERT_TRUE(engine.hasOrder(instrument, orderId));
+
+    engine.removeOrderBook(instrument);
+    // The symbol stays registered, so the gateway still routes messages for it
+    EXPECT_FALSE(engine.hasOrder(instrument, orderId));
+    engine.cancelOrder(orderId, instrument);
+    engine.modifyOrder(orderId, instrument, 151, 50);
+    EXPECT_EQ(engine.getOrderBookForRead(instrument), nullptr);
+}
+
+TEST(MatchingEngineTest, ExistingBookKeepsItsTickSize)
+{
+    MatchingEngine engine;
+    InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    ASSERT_TRUE(engine.createNewOrderBook("TICK_BOOK", 0.05));
+    const InstrumentId instrument = registry.resolve("TICK_BOOK");
+
+    EXPECT_FALSE(engine.createNewOrderBook("TICK_BOOK", 0.05));
+    EXPECT_THROW(engine.createNewOrderBook("TICK_BOOK", 0.01), std::invalid_argument);
+    EXPECT_THROW(registry.registerInstrument("TICK_BOOK", 0.01), std::invalid_argument);
+    EXPECT_EQ(registry.getTickSize(instrument), 0.05);
+    EXPECT_EQ(registry.toTicks(instrument, 1.5), 30);
+
+    // Without a book the tick size may change again
+    engine.removeOrderBook(instrument);
+    registry.registerInstrument("TICK_BOOK", 0.01);
+    EXPECT_EQ(registry.getTickSize(instrument), 0.01);
+}
+
+TEST(MatchingEngineTest, LookupsRunAlongsideDirectoryChanges)
+{
+    MatchingEngine engine;
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
+
+    std::atomic<bool> done{false};
+    std::thread reader([&]() {
+        while (!done.load()) {
+            const OrderBook *book = engine.getOrderBookForRead(instrument);
+            ASSERT_NE(book, nullptr);
+            // Nothing rests in the book, every read must see it empty
+            EXPECT_EQ(book->getBestBid(), nullptr);
+        }
+    });
+
+    for (int i = 0; i < 200; ++i) {
+        engine.createNewOrderBook("LOOKUP" + std::to_string(i));
+    }
+    done = true;
+    reader.join();
+    EXPECT_TRUE(engine.hasInstrument(InstrumentRegistry::getInstance().resolve("LOOKUP199")));
+}
+
+TEST(MatchingEngineTest, ExecutionSinkReceivesFillsInOrder)
+{
+    MatchingEngine engine;
+    engine.createNewOrderBook("AAPL");
+    const InstrumentId instrument = InstrumentRegistry::getInstance().resolve("AAPL");
+    OrderPool &pool = engine.getOrderPool();
+
+    for (int i = 0; i < 3; ++i) {
+        engine.processNewOrder(pool.createLimitOrder(IDGenerator::getInstance().getNextOrderID(), instrument, 100 + i, 10, false));
+    }
+
+    struct RecordingSink final : ExecutionSink {
+        std::vector<Trade> fills;
+        void onTrade(const Trade &trade) override { fills.push_back(trade); }
+    } sink;
+
+    // Takes both makers at 100 and 101 and part of the one at 102
+    const unsigned int takerId = IDGenerator::getInstance().getNextOrderID();
+    engine.processNewOrder(pool.createLimitOrder(takerId, instrument, 102, 25, true), sink);
+
+    ASSERT_EQ(sink.fills.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(sink.fills[i].getPrice(), 100 + i);
+        EXPECT_EQ(sink.fills[i].getBuyOrderId(), takerId);
+    }
+    EXPECT_EQ(sink.fills[0].getSellOrderStatus(), TradeStatus::SUCCESS);
+    EXPECT_EQ(sink.fills[0].getBuyOrderStatus(), TradeStatus::PARTIALLY_FILLED);
+    EXPECT_EQ(sink.fills[2].getQuantity(), 5);
+    EXPECT_EQ(sink.fills[2].getSellOrderStatus(), TradeStatus::PARTIALLY_FILLED);
+    EXPECT_EQ(sink.fills[2].getBuyOrderStatus(), TradeStatus::SUCCESS);
+    EXPECT_EQ(sink.fills[0].getBuyLeavesQuantity(), 15);
+    EXPECT_EQ(sink.fills[2].getBuyLeavesQuantity(), 0);
+    EXPECT_EQ(sink.fills[2].getSellLeavesQuantity(), 5);
+    EXPECT_EQ(engine.getLastTradePrice(instrument), 102);
+    // All fills of one incoming order are stamped with the same time
+    EXPECT_EQ(sink.fills[0].getTimestamp(), sink.fills[2].getTimestamp());
+    EXPECT_EQ(formatTrade(sink.fills[2], "csv").rfind(std::to_string(sink.fills[2].getTradeId()) + ",", 0), 0);
+
+    // A modify crossing the spread reports through the engine's sink
+    RecordingSink engineSink;
+    engine.setExecutionSink(&engineSink);
+    const unsigned int bidId = IDGenerator::getInstance().getNextOrderID();
+    engine.processNewOrder(pool.createLimitOrder(bidId, instrument, 90, 5, true));
+    engine.modifyOrder(bidId, instrument, 102, 5);
+    ASSERT_EQ(engineSink.fills.size(), 1);
+    EXPECT_EQ(engineSink.fills[0].getBuyOrderId(), bidId);
+    engine.setExecutionSink(nullptr);
+}
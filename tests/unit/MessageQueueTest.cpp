@@ -1,14 +1,20 @@
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <vector>
 #include "MessageQueue.h"
+#include "InstrumentRegistry.hpp"
 #include "Message.hpp"
 
 class MessageQueueTest : public ::testing::Test {
 protected:
     MessageQueue queue;
+    InstrumentId instrument{};
 
-    void SetUp() override {}
+    void SetUp() override {
+        instrument = InstrumentRegistry::getInstance().registerInstrument("AAPL");
+    }
 
     void TearDown() override {}
 };
@@ -20,7 +26,7 @@ TEST_F(MessageQueueTest, IsEmptyInitially) {
 
 
 TEST_F(MessageQueueTest, PushAndPopSingleMessage) {
-    Message msg = Message::createAddOrderMessage("AAPL", 155.0, 100, true, OrderType::LIMIT);
+    Message msg = Message::createAddOrderMessage(instrument, 155, 100, true, OrderType::LIMIT);
     queue.push(std::move(msg));
     EXPECT_FALSE(queue.empty());
     EXPECT_EQ(queue.size(), 1);
@@ -33,14 +39,16 @@ TEST_F(MessageQueueTest, PushAndPopSingleMessage) {
 }
 
 TEST_F(MessageQueueTest, TryPopSuccess) {
-    Message msg = Message::createAddOrderMessage("AAPL", 155.0, 100, true, OrderType::LIMIT);
+    Message msg = Message::createAddOrderMessage(instrument, 155, 100, true, OrderType::LIMIT);
+    msg.timestamp = monotonicNow();
+    const Timestamp pushedTimestamp = msg.timestamp;
     queue.push(std::move(msg));
 
     Message poppedMsg;
     bool success = queue.tryPop(poppedMsg);
     EXPECT_TRUE(success);
     EXPECT_TRUE(queue.empty());
-    EXPECT_EQ(poppedMsg.time, msg.time);
+    EXPECT_EQ(poppedMsg.timestamp, pushedTimestamp);
 }
 
 TEST_F(MessageQueueTest, TryPopFailureWhenEmpty) {
@@ -51,8 +59,8 @@ TEST_F(MessageQueueTest, TryPopFailureWhenEmpty) {
 
 TEST_F(MessageQueueTest, QueueSize) {
     EXPECT_EQ(queue.size(), 0);
-    Message msg1 = Message::createAddOrderMessage("AAPL", 155.0, 100, true, OrderType::LIMIT);
-    Message msg2 = Message::createAddOrderMessage("AAPL", 170.0, 150, false, OrderType::LIMIT);
+    Message msg1 = Message::createAddOrderMessage(instrument, 155, 100, true, OrderType::LIMIT);
+    Message msg2 = Message::createAddOrderMessage(instrument, 170, 150, false, OrderType::LIMIT);
     queue.push(std::move(msg1));
     EXPECT_EQ(queue.size(), 1);
     queue.push(std::move(msg2));
@@ -76,7 +84,7 @@ TEST_F(MessageQueueTest, MultipleProducersSingleConsumer) {
     for (int i = 0; i < numProducers; ++i) {
         producers.emplace_back([&, i]() {
             for (int j = 0; j < messagesPerProducer; ++j) {
-                Message msg = Message::createAddOrderMessage("AAPL", 155.0 + i, 100 + j, true, OrderType::LIMIT);
+                Message msg = Message::createAddOrderMessage(instrument, 155 + i, 100 + j, true, OrderType::LIMIT);
                 queue.push(std::move(msg));
             }
         });
@@ -110,3 +118,136 @@ TEST_F(MessageQueueTest, MultipleProducersSingleConsumer) {
     EXPECT_EQ(consumedMessages.size(), numProducers * messagesPerProducer);
     EXPECT_TRUE(queue.empty());
 }
+
+TEST_F(MessageQueueTest, CapacityIsRoundedUpToPowerOfTwo) {
+    MessageQueue small(5);
+    EXPECT_EQ(small.capacity(), 8);
+    EXPECT_EQ(queue.capacity(), Utility_Config::MessageQueue::DEFAULT_CAPACITY);
+}
+
+TEST_F(MessageQueueTest, TryPushFailsWhenFull) {
+    MessageQueue small(4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(small.tryPush(Message::createAddOrderMessage(instrument, 155, 100 + i, true, OrderType::LIMIT)));
+    }
+    EXPECT_EQ(small.size(), 4);
+
+    Message rejected = Message::createAddOrderMessage(instrument, 155, 999, true, OrderType::LIMIT);
+    EXPECT_FALSE(small.tryPush(std::move(rejected)));
+    // A rejected message is left with the caller
+    EXPECT_EQ(rejected.addOrderDetails->quantity, 999);
+
+    // Popping frees a slot, and the ring wraps around in FIFO order
+    Message poppedMsg;
+    ASSERT_TRUE(small.tryPop(poppedMsg));
+    EXPECT_EQ(poppedMsg.addOrderDetails->quantity, 100);
+    EXPECT_TRUE(small.tryPush(std::move(rejected)));
+    for (int expected : {101, 102, 103, 999}) {
+        ASSERT_TRUE(small.tryPop(poppedMsg));
+        EXPECT_EQ(poppedMsg.addOrderDetails->quantity, expected);
+    }
+    EXPECT_TRUE(small.empty());
+}
+
+TEST_F(MessageQueueTest, SingleProducerKeepsOrder) {
+    const int messageCount = 100000;
+    MessageQueue spsc(64, MessageQueue::ProducerMode::SINGLE);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < messageCount; ++i) {
+            spsc.push(Message::createAddOrderMessage(instrument, 155, i, true, OrderType::LIMIT));
+        }
+    });
+
+    int expected = 0;
+    Message msg;
+    while (expected < messageCount && spsc.pop(msg)) {
+        ASSERT_EQ(msg.addOrderDetails->quantity, expected);
+        ++expected;
+    }
+    producer.join();
+    EXPECT_EQ(expected, messageCount);
+    EXPECT_TRUE(spsc.empty());
+}
+
+TEST_F(MessageQueueTest, ShutdownWakesBlockedConsumer) {
+    std::atomic<bool> popResult{true};
+    std::thread consumer([&]() {
+        Message msg;
+        popResult = queue.pop(msg);
+    });
+
+    // Give the consumer time to park
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    queue.shutdown();
+    consumer.join();
+    EXPECT_FALSE(popResult);
+    EXPECT_TRUE(queue.isShutdown());
+}
+
+TEST_F(MessageQueueTest, PendingMessagesAreDeliveredAfterShutdown) {
+    queue.push(Message::createAddOrderMessage(instrument, 155, 100, true, OrderType::LIMIT));
+    queue.shutdown();
+
+    Message poppedMsg;
+    EXPECT_TRUE(queue.pop(poppedMsg));
+    EXPECT_FALSE(queue.pop(poppedMsg));
+}
+
+TEST_F(MessageQueueTest, ParseWaitStrategy) {
+    EXPECT_EQ(MessageQueue::parseWaitStrategy("busy_spin"), MessageQueue::WaitStrategy::BUSY_SPIN);
+    EXPECT_EQ(MessageQueue::parseWaitStrategy("spin_yield"), MessageQueue::WaitStrategy::SPIN_YIELD);
+    EXPECT_EQ(MessageQueue::parseWaitStrategy("spin_park"), MessageQueue::WaitStrategy::SPIN_PARK);
+    EXPECT_EQ(MessageQueue::parseWaitStrategy("blocking"), MessageQueue::WaitStrategy::BLOCKING);
+    EXPECT_THROW(MessageQueue::parseWaitStrategy("sleep"), std::invalid_argument);
+}
+
+TEST_F(MessageQueueTest, EveryWaitStrategyDeliversAndStops) {
+    for (const auto strategy : {MessageQueue::WaitStrategy::BUSY_SPIN, MessageQueue::WaitStrategy::SPIN_YIELD,
+                                MessageQueue::WaitStrategy::SPIN_PARK, MessageQueue::WaitStrategy::BLOCKING}) {
+        MessageQueue waiting(64, MessageQueue::ProducerMode::SINGLE, strategy);
+        std::atomic<int> received{0};
+        std::thread consumer([&]() {
+            Message msg;
+            while (waiting.pop(msg)) {
+                ++received;
+            }
+        });
+
+        // Pushes arriving after idle gaps find the consumer in its waiting state
+        for (int i = 0; i < 3; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            waiting.push(Message::createAddOrderMessage(instrument, 155, 100, true, OrderType::LIMIT));
+        }
+        while (received < 3) {
+            std::this_thread::yield();
+        }
+
+        waiting.shutdown();
+        consumer.join();
+        EXPECT_EQ(received, 3);
+    }
+}
+
+TEST_F(MessageQueueTest, PopBatchTakesWhatIsReady) {
+    for (int i = 0; i < 5; ++i) {
+        queue.push(Message::createAddOrderMessage(instrument, 155, i, true, OrderType::LIMIT));
+    }
+
+    std::vector<Message> batch;
+    EXPECT_EQ(queue.popBatch(batch, 3), 3);
+    EXPECT_EQ(batch.front().addOrderDetails->quantity, 0);
+    EXPECT_EQ(batch.back().addOrderDetails->quantity, 2);
+
+    // Fewer ready messages than requested
+    EXPECT_EQ(queue.drain(batch, 10), 2);
+    EXPECT_EQ(batch.front().addOrderDetails->quantity, 3);
+    EXPECT_EQ(batch.back().addOrderDetails->quantity, 4);
+    EXPECT_TRUE(queue.empty());
+
+    EXPECT_EQ(queue.drain(batch, 10), 0);
+    EXPECT_TRUE(batch.empty());
+
+    queue.shutdown();
+    EXPECT_EQ(queue.popBatch(batch, 10), 0);
+}
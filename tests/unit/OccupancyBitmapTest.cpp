@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include "OccupancyBitmap.h"
+
+TEST(OccupancyBitmapTest, EmptyBitmap)
+{
+    OccupancyBitmap bitmap(4096);
+    EXPECT_FALSE(bitmap.any());
+    EXPECT_EQ(bitmap.findNext(0), OccupancyBitmap::npos);
+    EXPECT_EQ(bitmap.findPrev(4095), OccupancyBitmap::npos);
+}
+
+TEST(OccupancyBitmapTest, FindAcrossWordBoundaries)
+{
+    OccupancyBitmap bitmap(OccupancyBitmap::MAX_SIZE);
+    bitmap.set(3);
+    bitmap.set(64);
+    bitmap.set(4095);
+    bitmap.set(4096);
+    bitmap.set(200000);
+
+    EXPECT_EQ(bitmap.findNext(0), 3);
+    EXPECT_EQ(bitmap.findNext(4), 64);
+    EXPECT_EQ(bitmap.findNext(65), 4095);
+    EXPECT_EQ(bitmap.findNext(4097), 200000);
+    EXPECT_EQ(bitmap.findNext(200001), OccupancyBitmap::npos);
+
+    EXPECT_EQ(bitmap.findPrev(OccupancyBitmap::MAX_SIZE - 1), 200000);
+    EXPECT_EQ(bitmap.findPrev(199999), 4096);
+    EXPECT_EQ(bitmap.findPrev(4095), 4095);
+    EXPECT_EQ(bitmap.findPrev(63), 3);
+    EXPECT_EQ(bitmap.findPrev(2), OccupancyBitmap::npos);
+
+    bitmap.clear(4095);
+    bitmap.clear(4096);
+    EXPECT_EQ(bitmap.findNext(65), 200000);
+    EXPECT_EQ(bitmap.findPrev(199999), 64);
+}
+
+TEST(OccupancyBitmapTest, MatchesOrderedSet)
+{
+    constexpr std::size_t size = 20000;
+    OccupancyBitmap bitmap(size);
+    std::set<std::size_t> reference;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<std::size_t> dist(0, size - 1);
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        const std::size_t index = dist(rng);
+        if (reference.count(index) != 0)
+        {
+            bitmap.clear(index);
+            reference.erase(index);
+        }
+        else
+        {
+            bitmap.set(index);
+            reference.insert(index);
+        }
+
+        const std::size_t probe = dist(rng);
+        const auto next = reference.lower_bound(probe);
+        EXPECT_EQ(bitmap.findNext(probe), next == reference.end() ? OccupancyBitmap::npos : *next);
+
+        auto prev = reference.upper_bound(probe);
+        EXPECT_EQ(bitmap.findPrev(probe), prev == reference.begin() ? OccupancyBitmap::npos : *(--prev));
+    }
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include "InstrumentRegistry.hpp"
+#include "OrderIdIndex.h"
+#include "OrderPool.h"
+
+class OrderIdIndexTest : public ::testing::Test {
+protected:
+    OrderPool pool;
+    std::vector<Order *> orders;
+
+    void SetUp() override {
+        for (unsigned int i = 0; i < 8; ++i) {
+            orders.push_back(pool.createLimitOrder(i + 1, InstrumentRegistry::getInstance().registerInstrument("AAPL"), 100, 10, true));
+        }
+    }
+
+    void TearDown() override {
+        for (Order *order : orders) {
+            pool.release(order);
+        }
+    }
+};
+
+TEST_F(OrderIdIndexTest, InsertFindErase)
+{
+    OrderIdIndex index;
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.find(1), nullptr);
+
+    index.insert(1, orders[0]);
+    index.insert(2, orders[1]);
+    EXPECT_EQ(index.find(1), orders[0]);
+    EXPECT_EQ(index.find(2), orders[1]);
+    EXPECT_FALSE(index.contains(3));
+    EXPECT_EQ(index.size(), 2);
+
+    // Overwriting keeps the count
+    index.insert(2, orders[2]);
+    EXPECT_EQ(index.find(2), orders[2]);
+    EXPECT_EQ(index.size(), 2);
+
+    EXPECT_TRUE(index.erase(1));
+    EXPECT_FALSE(index.erase(1));
+    EXPECT_EQ(index.find(1), nullptr);
+    EXPECT_EQ(index.size(), 1);
+}
+
+TEST_F(OrderIdIndexTest, CapacityFollowsLiveOrders)
+{
+    OrderIdIndex index(OrderIdIndex::MIN_CAPACITY / 2);
+    EXPECT_EQ(index.capacity(), OrderIdIndex::MIN_CAPACITY);
+    const auto count = static_cast<unsigned int>(64 * OrderIdIndex::MIN_CAPACITY);
+    for (unsigned int id = 1; id <= count; ++id) {
+        index.insert(id, orders[id % orders.size()]);
+    }
+    EXPECT_EQ(index.size(), count);
+    EXPECT_GE(index.capacity(), 2 * index.size());
+    for (unsigned int id = 1; id <= count; ++id) {
+        ASSERT_EQ(index.find(id), orders[id % orders.size()]);
+    }
+
+    // Emptying keeps the slots for the next orders instead of allocating again
+    const std::size_t capacity = index.capacity();
+    for (unsigned int id = 1; id <= count; ++id) {
+        ASSERT_TRUE(index.erase(id));
+    }
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.capacity(), capacity);
+}
+
+TEST_F(OrderIdIndexTest, InterleavedIdsAcrossBooks)
+{
+    // One global ID sequence spread over several books, each keeping a few long-lived resting orders
+    constexpr unsigned int bookCount = 8;
+    constexpr unsigned int idCount = 2000000;
+    constexpr unsigned int restingEvery = 4099;
+    std::vector<OrderIdIndex> books(bookCount);
+    const std::size_t initialCapacity = books[0].capacity();
+    for (unsigned int id = 1; id <= idCount; ++id) {
+        OrderIdIndex &book = books[id % bookCount];
+        book.insert(id, orders[0]);
+        if (id % restingEvery != 0) {
+            book.erase(id);
+        }
+    }
+
+    std::size_t resting = 0;
+    for (const OrderIdIndex &book : books) {
+        resting += book.size();
+        // Resting orders millions of IDs apart still fit the initial table
+        EXPECT_EQ(book.capacity(), initialCapacity);
+    }
+    EXPECT_EQ(resting, idCount / restingEvery);
+    for (unsigned int id = restingEvery; id <= idCount; id += restingEvery) {
+        EXPECT_EQ(books[id % bookCount].find(id), orders[0]);
+    }
+}
+
+TEST_F(OrderIdIndexTest, PresizedIndexNeverGrows)
+{
+    constexpr unsigned int expected = 5000;
+    OrderIdIndex index(expected);
+    const std::size_t capacity = index.capacity();
+    EXPECT_GE(capacity, 2 * expected);
+    for (unsigned int id = 1; id <= expected; ++id) {
+        index.insert(id, orders[id % orders.size()]);
+    }
+    EXPECT_EQ(index.capacity(), capacity);
+    EXPECT_EQ(index.find(expected), orders[expected % orders.size()]);
+}
+
+TEST_F(OrderIdIndexTest, MatchesUnorderedMap)
+{
+    OrderIdIndex index;
+    std::unordered_map<unsigned int, Order *> reference;
+    std::mt19937 rng(7);
+    unsigned int nextId = 1;
+
+    // A sliding window of live IDs, as resting orders come and go
+    for (int i = 0; i < 50000; ++i)
+    {
+        if (reference.empty() || rng() % 3 != 0)
+        {
+            Order *order = orders[rng() % orders.size()];
+            index.insert(nextId, order);
+            reference[nextId] = order;
+            nextId += 1 + rng() % 3;
+        }
+        else
+        {
+            const unsigned int probe = nextId - 1 - rng() % 20000;
+            EXPECT_EQ(index.erase(probe), reference.erase(probe) == 1);
+        }
+
+        const unsigned int probe = nextId - rng() % 30000;
+        const auto it = reference.find(probe);
+        EXPECT_EQ(index.find(probe), it == reference.end() ? nullptr : it->second);
+    }
+    EXPECT_EQ(index.size(), reference.size());
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_set>
+#include "OrderIdTracker.h"
+
+TEST(OrderIdTrackerTest, EmptyTracker)
+{
+    OrderIdTracker tracker(1024);
+    EXPECT_FALSE(tracker.contains(1));
+    EXPECT_FALSE(tracker.contains(5000));
+    EXPECT_EQ(tracker.highWaterMark(), 0);
+    EXPECT_EQ(tracker.footprintBytes(), 1024 / 8);
+}
+
+TEST(OrderIdTrackerTest, TracksIdsInsideTheWindow)
+{
+    OrderIdTracker tracker(1024);
+    tracker.insert(1);
+    tracker.insert(3);
+    tracker.insert(700);
+
+    EXPECT_TRUE(tracker.contains(1));
+    EXPECT_FALSE(tracker.contains(2));
+    EXPECT_TRUE(tracker.contains(3));
+    EXPECT_TRUE(tracker.contains(700));
+    EXPECT_FALSE(tracker.contains(701));
+    EXPECT_EQ(tracker.highWaterMark(), 700);
+}
+
+TEST(OrderIdTrackerTest, WindowSlidesWithTheHighestId)
+{
+    OrderIdTracker tracker(1024);
+    tracker.insert(10);
+    tracker.insert(5000);
+
+    // The window now ends at 5000's word, everything below its start counts as seen
+    EXPECT_GT(tracker.windowStart(), 10);
+    EXPECT_LE(tracker.windowStart(), 5000 - 1024 + 64);
+    EXPECT_TRUE(tracker.contains(10));
+    EXPECT_TRUE(tracker.contains(tracker.windowStart() - 1));
+    EXPECT_FALSE(tracker.contains(tracker.windowStart()));
+    EXPECT_TRUE(tracker.contains(5000));
+
+    // Recycled words start out empty
+    EXPECT_FALSE(tracker.contains(4999));
+    tracker.insert(4999);
+    EXPECT_TRUE(tracker.contains(4999));
+    EXPECT_EQ(tracker.footprintBytes(), 1024 / 8);
+}
+
+TEST(OrderIdTrackerTest, MatchesSetWithinTheWindow)
+{
+    constexpr std::size_t window = 4096;
+    OrderIdTracker tracker(window);
+    std::unordered_set<unsigned int> reference;
+    std::mt19937 rng(7);
+    unsigned int nextId = 1;
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        // Monotonic IDs with gaps, as a shard sees them
+        nextId += 1 + rng() % 4;
+        tracker.insert(nextId);
+        reference.insert(nextId);
+
+        const unsigned int probe = nextId - rng() % (window / 2);
+        EXPECT_EQ(tracker.contains(probe), reference.count(probe) != 0);
+    }
+}
+
+TEST(OrderIdTrackerTest, RejectsEmptyWindow)
+{
+    EXPECT_THROW(OrderIdTracker(0), std::invalid_argument);
+}
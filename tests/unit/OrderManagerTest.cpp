@@ -3,6 +3,7 @@
 #include <thread>
 #include "test_config.hpp"
 #include "MessageQueue.h"
+#include "InstrumentRegistry.hpp"
 #include "Message.hpp"
 #include "MatchingEngine.h"
 #include "OrderManager.h"
@@ -13,10 +14,12 @@ protected:
     MatchingEngine engine;
     OrderManager manager{&engine, queue}; // 直接初始化
     // OrderManager manager = OrderManager(&engine, queue);
+    InstrumentId instrument{};
 
     void SetUp() override 
     {
-        engine.createNewOrderBook("AAPL");
+        engine.createNewOrderBook(TEST_Config::OrderManager::INSTRUMENT);
+        instrument = InstrumentRegistry::getInstance().resolve(TEST_Config::OrderManager::INSTRUMENT);
     }
 
     void TearDown() override {}
@@ -25,12 +28,12 @@ protected:
 TEST_F(OrderManagerTest, BasicTest)
 {
 
-    Message msg = Message::createAddOrderMessage("AAPL", 155.0, 100, false, OrderType::LIMIT);
+    Message msg = Message::createAddOrderMessage(instrument, 155, 100, false, OrderType::LIMIT);
     manager.handleAddMessage(msg);
 
-    engine.getOrderBookForRead("AAPL")->printOrderBook();
-    ASSERT_NE(nullptr, engine.getOrderBookForRead("AAPL")->getBestAsk());
-    EXPECT_EQ(155, engine.getOrderBookForRead("AAPL")->getBestAsk()->getPrice());
+    engine.getOrderBookForRead(instrument)->printOrderBook();
+    ASSERT_NE(nullptr, engine.getOrderBookForRead(instrument)->getBestAsk());
+    EXPECT_EQ(155, engine.getOrderBookForRead(instrument)->getBestAsk()->getPrice());
 
     manager.handleAddMessage(msg);
 }
@@ -47,7 +50,7 @@ TEST_F(OrderManagerTest, MultithreadMessageQueueTest)
     for (int i = 0; i < numProducers; ++i) {
             producers.emplace_back([&, i]() {
             for (int j = 0; j < messagesPerProducer; ++j) {
-                Message msg = Message::createAddOrderMessage(TEST_Config::OrderManager::INSTRUMENT, TEST_Config::OrderManager::PRICE + i, 200 + j, false, OrderType::LIMIT);
+                Message msg = Message::createAddOrderMessage(instrument, TEST_Config::OrderManager::PRICE + i, 200 + j, false, OrderType::LIMIT);
                 queue.push(std::move(msg));
             }
         });
@@ -76,8 +79,8 @@ TEST_F(OrderManagerTest, MultithreadMessageQueueTest)
     inputThread.join();
 
     manager.stop();
-    ASSERT_NE(engine.getOrderBookForRead((TEST_Config::OrderManager::INSTRUMENT)), nullptr);
-    ASSERT_EQ(engine.getOrderBookForRead((TEST_Config::OrderManager::INSTRUMENT))->getBestAsk()->getPrice(), TEST_Config::OrderManager::PRICE);
+    ASSERT_NE(engine.getOrderBookForRead(instrument), nullptr);
+    ASSERT_EQ(engine.getOrderBookForRead(instrument)->getBestAsk()->getPrice(), TEST_Config::OrderManager::PRICE);
 }
 
 // TEST_F(OrderManagerTest, MultithreadMessageQueueTest1)
@@ -96,7 +99,7 @@ TEST_F(OrderManagerTest, MultithreadMessageQueueTest)
 //     for (int i = 0; i < numProducers; ++i) {
 //         producers.emplace_back([&, i]() {
 //             for (int j = 0; j < messagesPerProducer; ++j) {
-//                 Message msg = Message::createAddOrderMessage("AAPL", 160.0 + i, 200 + j, false, OrderType::LIMIT);
+//                 Message msg = Message::createAddOrderMessage("AAPL", 160 + i, 200 + j, false, OrderType::LIMIT);
 //                 queue.push(std::move(msg));
 //             }
 //         });
@@ -124,3 +127,24 @@ TEST_F(OrderManagerTest, MultithreadMessageQueueTest)
 //         inputThread.join();
 //     }
 // }
+
+TEST_F(OrderManagerTest, BatchedProcessing)
+{
+    OrderManager batchManager{&engine, queue, nullptr, 4};
+    constexpr int messageCount = 10;
+    for (int i = 0; i < messageCount; ++i) {
+        queue.push(Message::createAddOrderMessage(instrument, TEST_Config::OrderManager::PRICE + i, 100, false, OrderType::LIMIT));
+    }
+
+    batchManager.start();
+    while (!queue.empty()) {
+        std::this_thread::yield();
+    }
+    // The batch in flight is finished before the processing thread exits
+    batchManager.stop();
+
+    const OrderBook *book = engine.getOrderBookForRead(instrument);
+    ASSERT_NE(book->getBestAsk(), nullptr);
+    EXPECT_EQ(book->getBestAsk()->getPrice(), TEST_Config::OrderManager::PRICE);
+    EXPECT_EQ(book->getPriceLevelStats().inUse, messageCount);
+}
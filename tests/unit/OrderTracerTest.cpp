@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "OrderTracer.h"
+
+TEST(OrderTracerTest, SamplesOneMessageInInterval)
+{
+    OrderTracer &tracer = OrderTracer::getInstance();
+    // The sampling countdown is per thread, a fresh thread starts from a clean one
+    std::thread([&tracer]()
+    {
+        tracer.setSampleInterval(4);
+        int sampled = 0;
+        for (int i = 0; i < 100; ++i)
+        {
+            if (tracer.sample() != 0)
+            {
+                ++sampled;
+            }
+        }
+        EXPECT_EQ(sampled, 25);
+
+        tracer.setSampleInterval(0);
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_EQ(tracer.sample(), 0);
+        }
+    }).join();
+}
+
+TEST(OrderTracerTest, ChromeTraceSpansEveryStage)
+{
+    OrderTracer &tracer = OrderTracer::getInstance();
+    tracer.reset();
+    tracer.setSampleInterval(1);
+    const std::uint32_t traceId = tracer.sample();
+    tracer.setSampleInterval(0);
+    ASSERT_NE(traceId, 0);
+
+    // Gateway and matching stages on two threads, as in the running system
+    tracer.record(traceId, TraceStage::GATEWAY_READ);
+    tracer.record(traceId, TraceStage::QUEUE_PUSH);
+    std::thread([&tracer, traceId]()
+    {
+        tracer.record(traceId, TraceStage::DEQUEUE);
+        tracer.record(traceId, TraceStage::MATCH_BEGIN);
+        tracer.record(traceId, TraceStage::MATCH_END);
+        tracer.record(traceId, TraceStage::ACK_QUEUED);
+    }).join();
+    tracer.record(traceId, TraceStage::ACK_WRITTEN);
+    tracer.record(0, TraceStage::ACK_WRITTEN);  // Untraced messages leave nothing behind
+
+    std::ostringstream out;
+    EXPECT_EQ(tracer.writeChromeTrace(out), 7);
+
+    // Stamps of one order come out in path order, each a span up to the next one and the last an instant
+    const std::string trace = out.str();
+    const std::vector<std::string> expected{"gateway_read", "queue_push", "dequeue", "match", "match_end", "ack_queued", "ack_written"};
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        position = trace.find(R"({"name":")" + expected[i] + "\"", position);
+        ASSERT_NE(position, std::string::npos) << expected[i];
+        const std::string event = trace.substr(position, trace.find('\n', position) - position);
+        EXPECT_NE(event.find(i + 1 < expected.size() ? R"("ph":"X","dur":)" : R"("ph":"i")"), std::string::npos) << event;
+        EXPECT_NE(event.find(R"("trace_id":)" + std::to_string(traceId) + "}"), std::string::npos) << event;
+    }
+    EXPECT_EQ(trace.find(R"("ph":"X","dur":-)"), std::string::npos);
+    tracer.reset();
+}
+
+TEST(OrderTracerTest, BufferKeepsTheNewestEvents)
+{
+    OrderTracer &tracer = OrderTracer::getInstance();
+    tracer.reset();
+    std::thread([&tracer]()
+    {
+        for (std::uint32_t i = 1; i <= Utility_Config::Tracing::BUFFER_EVENTS + 10; ++i)
+        {
+            tracer.record(i, TraceStage::GATEWAY_READ);
+        }
+    }).join();
+
+    std::ostringstream out;
+    // The oldest ten were overwritten; the slot the owner would write next is skipped too, as a writer
+    // could be in the middle of it
+    EXPECT_EQ(tracer.writeChromeTrace(out), Utility_Config::Tracing::BUFFER_EVENTS - 1);
+    EXPECT_EQ(out.str().find(R"("trace_id":11})"), std::string::npos);
+    EXPECT_NE(out.str().find(R"("trace_id":12})"), std::string::npos);
+    tracer.reset();
+}
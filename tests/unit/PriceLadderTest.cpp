@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include "PriceLadder.h"
+
+struct TestLevel
+{
+    Price price;
+};
+
+TEST(PriceLadderTest, InsertFindErase)
+{
+    PriceLadder<TestLevel> ladder(16, 2, true);
+    TestLevel level{100};
+
+    ladder.insert(100, &level);
+    EXPECT_EQ(ladder.find(100), &level);
+    EXPECT_EQ(ladder.find(101), nullptr);
+    EXPECT_EQ(ladder.size(), 1);
+
+    ladder.erase(100);
+    EXPECT_EQ(ladder.find(100), nullptr);
+    EXPECT_TRUE(ladder.empty());
+}
+
+TEST(PriceLadderTest, FarPricesGoToOverflow)
+{
+    // Bids: the best price is anchored near the top of the window, far worse prices overflow
+    PriceLadder<TestLevel> ladder(16, 2, true);
+    TestLevel best{100};
+    TestLevel far{10};
+
+    ladder.insert(100, &best);
+    ladder.insert(10, &far);
+
+    EXPECT_EQ(ladder.overflowSize(), 1);
+    EXPECT_EQ(ladder.find(10), &far);
+    EXPECT_EQ(ladder.best(), &best);
+    EXPECT_EQ(ladder.findBetter(10), &best);
+    EXPECT_EQ(ladder.findBetter(100), nullptr);
+}
+
+TEST(PriceLadderTest, ReanchorsOnNewBestOutsideWindow)
+{
+    // Asks: a new best price below the window moves the anchor down
+    PriceLadder<TestLevel> ladder(16, 2, false);
+    TestLevel first{100};
+    TestLevel better{50};
+
+    ladder.insert(100, &first);
+    ladder.insert(50, &better);
+
+    EXPECT_EQ(ladder.getAnchor(), 48);
+    EXPECT_EQ(ladder.best(), &better);
+    EXPECT_EQ(ladder.findBetter(100), &better);
+    EXPECT_EQ(ladder.find(100), &first);
+
+    // When the window runs empty the ladder follows the best remaining price
+    ladder.erase(50);
+    EXPECT_EQ(ladder.best(), &first);
+    EXPECT_EQ(ladder.overflowSize(), 0);
+}
+
+TEST(PriceLadderTest, FindBetterPicksNearestNeighbour)
+{
+    PriceLadder<TestLevel> ladder(16, 2, true);
+    TestLevel levels[] = {{100}, {97}, {95}};
+    for (auto &level : levels)
+    {
+        ladder.insert(level.price, &level);
+    }
+
+    EXPECT_EQ(ladder.findBetter(96), &levels[1]);
+    EXPECT_EQ(ladder.findBetter(98), &levels[0]);
+    EXPECT_EQ(ladder.findBetter(101), nullptr);
+}
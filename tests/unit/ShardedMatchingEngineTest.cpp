@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InstrumentRegistry.hpp"
+#include "Message.hpp"
+#include "ShardedMatchingEngine.h"
+
+class ShardedMatchingEngineTest : public ::testing::Test {
+protected:
+    static constexpr std::size_t shardCount = 3;
+    ShardedMatchingEngine engine{shardCount};
+    std::vector<InstrumentId> instruments;
+
+    void SetUp() override {
+        for (int i = 0; i < 6; ++i) {
+            const std::string symbol = "SHARD" + std::to_string(i);
+            engine.createNewOrderBook(symbol);
+            instruments.push_back(InstrumentRegistry::getInstance().resolve(symbol));
+        }
+    }
+
+    void waitForProcessed(const std::uint64_t count) const {
+        while (engine.getProcessedCount() < count) {
+            std::this_thread::yield();
+        }
+    }
+};
+
+TEST_F(ShardedMatchingEngineTest, BooksLiveOnTheOwningShard) {
+    for (const InstrumentId instrument : instruments) {
+        const std::size_t owner = engine.getShardIndex(instrument);
+        EXPECT_EQ(owner, MessageRouter::shardOf(instrument, shardCount));
+        for (std::size_t shard = 0; shard < shardCount; ++shard) {
+            EXPECT_EQ(engine.getEngine(shard).hasInstrument(instrument), shard == owner);
+        }
+    }
+}
+
+TEST_F(ShardedMatchingEngineTest, RoutedOrdersMatchOnTheirShard) {
+    MessageRouter router = engine.getRouter();
+    ASSERT_EQ(router.getShardCount(), shardCount);
+    engine.start();
+
+    // Per instrument: a resting ask, then a bid crossing it, then an ask resting above
+    for (const InstrumentId instrument : instruments) {
+        router.route(Message::createAddOrderMessage(instrument, 100, 10, false, OrderType::LIMIT));
+    }
+    for (const InstrumentId instrument : instruments) {
+        router.route(Message::createAddOrderMessage(instrument, 100, 10, true, OrderType::LIMIT));
+        router.route(Message::createAddOrderMessage(instrument, 105, 5, false, OrderType::LIMIT));
+    }
+    waitForProcessed(3 * instruments.size());
+    engine.stop();
+
+    for (const InstrumentId instrument : instruments) {
+        MatchingEngine &owner = engine.getEngineFor(instrument);
+        EXPECT_EQ(owner.getLastTradePrice(instrument), 100);
+        const OrderBook *book = owner.getOrderBookForRead(instrument);
+        ASSERT_NE(book->getBestAsk(), nullptr);
+        EXPECT_EQ(book->getBestAsk()->getPrice(), 105);
+        EXPECT_EQ(book->getBestBid(), nullptr);
+    }
+}
+
+TEST_F(ShardedMatchingEngineTest, OrderingIsStrictPerInstrument) {
+    MessageRouter router = engine.getRouter();
+    engine.start();
+
+    // Each bid crosses exactly the ask sent just before it, so trade prices rise only if arrival order is kept
+    constexpr int pairsPerInstrument = 300;
+    for (int i = 0; i < pairsPerInstrument; ++i) {
+        for (const InstrumentId instrument : instruments) {
+            router.route(Message::createAddOrderMessage(instrument, 1000 + i, 1, false, OrderType::LIMIT));
+            router.route(Message::createAddOrderMessage(instrument, 1000 + i, 1, true, OrderType::LIMIT));
+        }
+    }
+    waitForProcessed(2 * pairsPerInstrument * instruments.size());
+    engine.stop();
+
+    for (std::size_t shard = 0; shard < shardCount; ++shard) {
+        std::vector<Price> lastPrice(InstrumentRegistry::MAX_INSTRUMENTS, 999);
+        std::vector<int> tradeCount(InstrumentRegistry::MAX_INSTRUMENTS, 0);
+        for (const Trade &trade : engine.getEngine(shard).getTrades()) {
+            EXPECT_EQ(trade.getPrice(), lastPrice[trade.getInstrument()] + 1);
+            lastPrice[trade.getInstrument()] = trade.getPrice();
+            ++tradeCount[trade.getInstrument()];
+        }
+        for (const InstrumentId instrument : instruments) {
+            if (engine.getShardIndex(instrument) == shard) {
+                EXPECT_EQ(tradeCount[instrument], pairsPerInstrument);
+            }
+        }
+    }
+}
+
+TEST_F(ShardedMatchingEngineTest, ShardsHandOutDisjointIds) {
+    MessageRouter router = engine.getRouter();
+    engine.start();
+    for (const InstrumentId instrument : instruments) {
+        router.route(Message::createAddOrderMessage(instrument, 100, 10, false, OrderType::LIMIT));
+        router.route(Message::createAddOrderMessage(instrument, 100, 10, true, OrderType::LIMIT));
+    }
+    waitForProcessed(2 * instruments.size());
+    engine.stop();
+
+    // Three shards take the two low bits of every ID, each ID names the shard that handed it out
+    std::set<unsigned int> tradeIds;
+    std::set<unsigned int> orderIds;
+    for (std::size_t shard = 0; shard < shardCount; ++shard) {
+        for (const Trade &trade : engine.getEngine(shard).getTrades()) {
+            EXPECT_EQ(trade.getTradeId() & 3, shard);
+            EXPECT_EQ(trade.getBuyOrderId() & 3, shard);
+            EXPECT_EQ(trade.getSellOrderId() & 3, shard);
+            EXPECT_TRUE(tradeIds.insert(trade.getTradeId()).second);
+            EXPECT_TRUE(orderIds.insert(trade.getBuyOrderId()).second);
+            EXPECT_TRUE(orderIds.insert(trade.getSellOrderId()).second);
+        }
+    }
+    EXPECT_EQ(tradeIds.size(), instruments.size());
+}
+
+TEST_F(ShardedMatchingEngineTest, RejectsZeroShards) {
+    EXPECT_THROW(ShardedMatchingEngine(0), std::invalid_argument);
+}
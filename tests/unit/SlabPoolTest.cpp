@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "SlabPool.hpp"
+
+struct TestNode
+{
+    int value = 7;
+    TestNode *next = nullptr;
+};
+
+TEST(SlabPoolTest, AcquireConstructsObjects)
+{
+    SlabPool<TestNode> pool(4);
+    TestNode *node = pool.acquire();
+    EXPECT_EQ(node->value, 7);
+    EXPECT_EQ(node->next, nullptr);
+
+    node->value = 42;
+    pool.release(node);
+
+    // A released slot is handed out again, freshly constructed
+    TestNode *reused = pool.acquire();
+    EXPECT_EQ(reused, node);
+    EXPECT_EQ(reused->value, 7);
+}
+
+TEST(SlabPoolTest, GrowsOneChunkAtATime)
+{
+    SlabPool<TestNode> pool(4);
+    EXPECT_EQ(pool.getStats().chunkCount, 1);
+    EXPECT_EQ(pool.getStats().capacity, 4);
+
+    std::vector<TestNode *> nodes;
+    for (int i = 0; i < 9; ++i)
+    {
+        nodes.push_back(pool.acquire());
+    }
+    EXPECT_EQ(pool.getStats().chunkCount, 3);
+    EXPECT_EQ(pool.getStats().capacity, 12);
+    EXPECT_EQ(pool.getStats().inUse, 9);
+
+    // Every object gets its own slot
+    EXPECT_EQ(std::set<TestNode *>(nodes.begin(), nodes.end()).size(), nodes.size());
+
+    for (TestNode *node : nodes)
+    {
+        pool.release(node);
+    }
+    const SlabPoolStats &stats = pool.getStats();
+    EXPECT_EQ(stats.inUse, 0);
+    EXPECT_EQ(stats.peakInUse, 9);
+    EXPECT_EQ(stats.acquireCount, 9);
+    EXPECT_EQ(stats.releaseCount, 9);
+    EXPECT_GE(stats.footprintBytes, 12 * sizeof(TestNode));
+
+    // Released memory is reused before a new chunk is allocated
+    for (int i = 0; i < 12; ++i)
+    {
+        pool.acquire();
+    }
+    EXPECT_EQ(pool.getStats().chunkCount, 3);
+}
+
+TEST(SlabPoolTest, ChunksAreCacheLineAligned)
+{
+    SlabPool<TestNode> pool(3, 2);
+    TestNode *first = pool.acquire();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % SlabPool<TestNode>::CACHE_LINE_SIZE, 0);
+
+    // Objects of a fresh chunk are laid out next to each other
+    TestNode *second = pool.acquire();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) - reinterpret_cast<std::uintptr_t>(first), sizeof(TestNode));
+}
+
+TEST(SlabPoolTest, RejectsEmptyChunks)
+{
+    EXPECT_THROW(SlabPool<TestNode>(0), std::invalid_argument);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "SplitSlabPool.hpp"
+
+struct HotNode
+{
+    int value;
+    HotNode *next = nullptr;
+
+    explicit HotNode(const int value) : value(value) {}
+};
+
+struct ColdNode
+{
+    long long payload = 0;
+};
+
+using TestPool = SplitSlabPool<HotNode, ColdNode, 4096>;
+
+TEST(SplitSlabPoolTest, ColdRecordFollowsFromTheAddress)
+{
+    TestPool pool;
+    std::vector<HotNode *> nodes;
+    for (int i = 0; i < 3 * static_cast<int>(TestPool::OBJECTS_PER_CHUNK); ++i)
+    {
+        nodes.push_back(pool.acquire(i));
+        TestPool::cold(nodes.back()).payload = i * 10;
+    }
+    EXPECT_EQ(pool.getStats().chunkCount, 3);
+
+    std::set<const ColdNode *> coldRecords;
+    for (const HotNode *node : nodes)
+    {
+        EXPECT_EQ(TestPool::cold(node).payload, node->value * 10);
+        coldRecords.insert(&TestPool::cold(node));
+    }
+    // Every object has a cold record of its own
+    EXPECT_EQ(coldRecords.size(), nodes.size());
+
+    // Hot objects of a chunk are packed next to each other, away from the cold records
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(nodes[1]) - reinterpret_cast<std::uintptr_t>(nodes[0]), sizeof(HotNode));
+}
+
+TEST(SplitSlabPoolTest, ReleasedSlotsStartWithAFreshColdRecord)
+{
+    TestPool pool;
+    HotNode *node = pool.acquire(1);
+    TestPool::cold(node).payload = 99;
+    pool.release(node);
+
+    HotNode *reused = pool.acquire(2);
+    EXPECT_EQ(reused, node);
+    EXPECT_EQ(TestPool::cold(reused).payload, 0);
+    EXPECT_EQ(pool.getStats().inUse, 1);
+    EXPECT_EQ(pool.getStats().footprintBytes, 4096);
+}
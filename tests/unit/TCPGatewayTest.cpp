@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "InstrumentRegistry.hpp"
 #include "TCPGateway.h"
 #include "test_config.hpp"
 
@@ -22,6 +23,9 @@ protected:
 
     void SetUp() override
     {
+        InstrumentRegistry::getInstance().registerInstrument("AAPL");
+        InstrumentRegistry::getInstance().registerInstrument("GOOG");
+        InstrumentRegistry::getInstance().registerInstrument("MSFT");
         loop = uv_default_loop();
         gateway = std::make_unique<TCPGateway>(loop, messageQueue);
         completedConnections = 0;
@@ -103,8 +107,8 @@ TEST_F(TCPGatewayTest, ValidMessageParsing)
             })",
             [](const Message& message) {
                 ASSERT_EQ(message.type, MessageType::ADD_ORDER);
-                ASSERT_EQ(message.addOrderDetails->instrument, "AAPL");
-                ASSERT_DOUBLE_EQ(message.addOrderDetails->price, 150.5);
+                ASSERT_EQ(message.addOrderDetails->instrument, InstrumentRegistry::getInstance().find("AAPL"));
+                ASSERT_EQ(message.addOrderDetails->price, 15050);
                 ASSERT_EQ(message.addOrderDetails->quantity, 100);
                 ASSERT_TRUE(message.addOrderDetails->isBuy);
                 ASSERT_EQ(message.addOrderDetails->type, OrderType::LIMIT);
@@ -121,8 +125,8 @@ TEST_F(TCPGatewayTest, ValidMessageParsing)
             [](const Message& message) {
                 ASSERT_EQ(message.type, MessageType::MODIFY_ORDER);
                 ASSERT_EQ(message.modifyDetails->orderId, 12345);
-                ASSERT_EQ(message.modifyDetails->instrument, "AAPL");
-                ASSERT_DOUBLE_EQ(message.modifyDetails->newPrice, 155.0);
+                ASSERT_EQ(message.modifyDetails->instrument, InstrumentRegistry::getInstance().find("AAPL"));
+                ASSERT_EQ(message.modifyDetails->newPrice, 15500);
                 ASSERT_EQ(message.modifyDetails->newQuantity, 200);
             }
         },
@@ -135,7 +139,7 @@ TEST_F(TCPGatewayTest, ValidMessageParsing)
             [](const Message& message) {
                 ASSERT_EQ(message.type, MessageType::CANCEL_ORDER);
                 ASSERT_EQ(message.cancelDetails->orderId, 54321);
-                ASSERT_EQ(message.cancelDetails->instrument, "AAPL");
+                ASSERT_EQ(message.cancelDetails->instrument, InstrumentRegistry::getInstance().find("AAPL"));
             }
         }
     };
@@ -160,12 +164,16 @@ TEST_F(TCPGatewayTest, InvalidMessageHandling)
         R"({ "type": "ADD_ORDER", "price": 150.5, "quantity": 100 })",
         R"({ "type": "MODIFY_ORDER", "orderId": "invalid_id", "newPrice": 155.0 })", 
         R"({ "type": "CANCEL_ORDER" })", 
+        R"({ "type": "CANCEL_ORDER", "orderId": 1, "instrument": "UNLISTED" })",
+        R"({ "type": "ADD_ORDER", "instrument": "AAPL", "price": 150.255, "quantity": 100, "isBuy": true, "orderType": "LIMIT" })",
     };
 
     unsigned int dummy_client_id = 0;
 
+    // Each one is rejected back to its client, none reaches the engine or escapes the event loop
     for (const auto& jsonMessage : invalidMessages) {
-        EXPECT_THROW({ gateway->receive(jsonMessage, dummy_client_id); }, std::invalid_argument);
+        EXPECT_NO_THROW({ gateway->receive(jsonMessage, dummy_client_id); });
+        EXPECT_TRUE(messageQueue.empty());
     }
 }
 
@@ -203,16 +211,16 @@ TEST_F(TCPGatewayTest, ConnectionTests)
         ASSERT_TRUE(success);
         if(i ==0){
             ASSERT_EQ(message.type, MessageType::ADD_ORDER);
-            ASSERT_EQ(message.addOrderDetails->instrument, "GOOG");
-            ASSERT_DOUBLE_EQ(message.addOrderDetails->price, 200.0);
+            ASSERT_EQ(message.addOrderDetails->instrument, InstrumentRegistry::getInstance().find("GOOG"));
+            ASSERT_EQ(message.addOrderDetails->price, -1); // market orders carry no price
             ASSERT_EQ(message.addOrderDetails->quantity, 50);
             ASSERT_FALSE(message.addOrderDetails->isBuy);
             ASSERT_EQ(message.addOrderDetails->type, OrderType::MARKET);
         }
         else{
             ASSERT_EQ(message.type, MessageType::ADD_ORDER);
-            ASSERT_EQ(message.addOrderDetails->instrument, "MSFT");
-            ASSERT_DOUBLE_EQ(message.addOrderDetails->price, 300.0);
+            ASSERT_EQ(message.addOrderDetails->instrument, InstrumentRegistry::getInstance().find("MSFT"));
+            ASSERT_EQ(message.addOrderDetails->price, 30000);
             ASSERT_EQ(message.addOrderDetails->quantity, 30);
             ASSERT_TRUE(message.addOrderDetails->isBuy);
             ASSERT_EQ(message.addOrderDetails->type, OrderType::LIMIT);
@@ -0,0 +1,44 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include "TimestampUtility.h"
+
+TEST(TimestampUtilityTest, ClockIsMonotonic)
+{
+    Timestamp previous = monotonicNow();
+    EXPECT_NE(previous, 0);
+    for (int i = 0; i < 100000; ++i)
+    {
+        const Timestamp current = monotonicNow();
+        ASSERT_GE(current, previous);
+        previous = current;
+    }
+}
+
+TEST(TimestampUtilityTest, TicksMeasureElapsedTime)
+{
+    const auto steadyStart = std::chrono::steady_clock::now();
+    const Timestamp start = monotonicNow();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const Timestamp end = monotonicNow();
+    const double steadyNanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - steadyStart).count();
+
+    // The calibrated rate is good to well under a percent, the tolerance covers scheduling noise
+    EXPECT_NEAR(ticksToNanoseconds(end - start), steadyNanoseconds, steadyNanoseconds * 0.05);
+}
+
+TEST(TimestampUtilityTest, WallClockConversion)
+{
+    const auto before = std::chrono::system_clock::now();
+    const Timestamp reading = monotonicNow();
+    const auto after = std::chrono::system_clock::now();
+
+    const auto wall = toWallClock(reading);
+    const auto slack = std::chrono::milliseconds(1);
+    EXPECT_GE(wall, before - slack);
+    EXPECT_LE(wall, after + slack);
+
+    // Later readings map to later wall times
+    EXPECT_LT(toWallClock(reading), toWallClock(reading + 1000000));
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include "IDGenerator.hpp"
+#include "InstrumentRegistry.hpp"
+#include "MatchingEngine.h"
+#include "TradeHistory.h"
+#include "TradeLog.h"
+
+class TradeHistoryTest : public ::testing::Test {
+protected:
+    InstrumentId instrument{};
+    std::string logPath;
+
+    void SetUp() override {
+        instrument = InstrumentRegistry::getInstance().registerInstrument("AAPL");
+        logPath = (std::filesystem::temp_directory_path() / "trade_history_test.bin").string();
+        std::filesystem::remove(logPath);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(logPath);
+        std::filesystem::remove(logPath + ".old");
+        for (int n = 1; n <= 4; ++n) {
+            std::filesystem::remove(logPath + ".old." + std::to_string(n));
+        }
+    }
+
+    [[nodiscard]] Trade makeTrade(const unsigned int tradeId) const {
+        return Trade(tradeId, 2 * tradeId, 2 * tradeId + 1, instrument, 15000 + tradeId, 10);
+    }
+};
+
+TEST_F(TradeHistoryTest, RingKeepsTheMostRecentTrades) {
+    TradeHistory history(4);
+    for (unsigned int id = 1; id <= 3; ++id) {
+        history.record(makeTrade(id));
+    }
+    EXPECT_EQ(history.recentCount(), 3);
+    EXPECT_EQ(history.recent(0).getTradeId(), 1);
+
+    for (unsigned int id = 4; id <= 10; ++id) {
+        history.record(makeTrade(id));
+    }
+    EXPECT_EQ(history.totalCount(), 10);
+    EXPECT_EQ(history.recentCount(), 4);
+    std::vector<Trade> recent = history.copyRecent();
+    ASSERT_EQ(recent.size(), 4);
+    for (unsigned int i = 0; i < 4; ++i) {
+        EXPECT_EQ(recent[i].getTradeId(), 7 + i);
+    }
+    EXPECT_THROW(static_cast<void>(history.recent(4)), std::out_of_range);
+    EXPECT_EQ(history.getLog(), nullptr);
+}
+
+TEST_F(TradeHistoryTest, FullHistorySpillsToTheLog) {
+    TradeHistory history(2, logPath);
+    for (unsigned int id = 1; id <= 100; ++id) {
+        history.record(makeTrade(id));
+    }
+
+    const TradeLog *log = history.getLog();
+    ASSERT_NE(log, nullptr);
+    ASSERT_EQ(log->size(), 100);
+    unsigned int expected = 1;
+    for (const Trade &trade : *log) {
+        EXPECT_EQ(trade.getTradeId(), expected);
+        EXPECT_EQ(trade.getPrice(), 15000 + expected);
+        EXPECT_EQ(trade.getInstrument(), instrument);
+        ++expected;
+    }
+
+    const auto found = log->lowerBound(42);
+    ASSERT_NE(found, log->end());
+    EXPECT_EQ(found->getTradeId(), 42);
+    EXPECT_EQ(found - log->begin(), 41);
+    EXPECT_EQ(log->lowerBound(1000), log->end());
+}
+
+TEST_F(TradeHistoryTest, LogGrowsAndSurvivesReopening) {
+    {
+        TradeLog log(logPath, 4);
+        const auto first = log.begin();
+        for (unsigned int id = 1; id <= 10; ++id) {
+            log.append(makeTrade(id));
+        }
+        EXPECT_EQ(log.size(), 10);
+        // The file grew in place
+        EXPECT_EQ(log.begin(), first);
+    }
+
+    TradeLog reopened(logPath, 4);
+    ASSERT_EQ(reopened.size(), 10);
+    EXPECT_EQ(reopened.at(9).getTradeId(), 10);
+    reopened.append(makeTrade(11));
+    EXPECT_EQ(reopened.size(), 11);
+    EXPECT_EQ(reopened.at(10).getTradeId(), 11);
+    EXPECT_THROW(static_cast<void>(reopened.at(11)), std::out_of_range);
+}
+
+TEST_F(TradeHistoryTest, IncompatibleFileIsMovedAside) {
+    {
+        std::ofstream foreign(logPath, std::ios::binary);
+        foreign << "not a trade log, but long enough to hold a log header: ................................";
+    }
+
+    TradeLog log(logPath, 4);
+    EXPECT_TRUE(log.empty());
+    ASSERT_TRUE(std::filesystem::exists(logPath + ".old"));
+    std::ifstream aside(logPath + ".old");
+    std::string firstWord;
+    aside >> firstWord;
+    EXPECT_EQ(firstWord, "not");
+}
+
+TEST_F(TradeHistoryTest, ReopenedLogContinuesTradeIds) {
+    constexpr unsigned int lastId = 1000;
+    {
+        TradeLog log(logPath, 4);
+        log.append(makeTrade(lastId));
+    }
+
+    // A restarted process hands out trade IDs from 1 again, the engine moves them past the log
+    MatchingEngine engine(logPath, 1, 2);
+    const unsigned int next = engine.getIDGenerator().getNextTradeID();
+    EXPECT_GT(next, lastId);
+    EXPECT_EQ(next & 3, 1);
+}
+
+TEST_F(TradeHistoryTest, FullReservationRollsOver) {
+    // One page of address space holds the header and perFile trades
+    const auto reserved = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t perFile = (reserved - sizeof(LogFileHeader)) / sizeof(Trade);
+    const auto total = static_cast<unsigned int>(3 * perFile + 5);
+    {
+        TradeLog log(logPath, 4, reserved);
+        for (unsigned int id = 1; id <= total; ++id) {
+            log.append(makeTrade(id));
+        }
+        ASSERT_EQ(log.size(), 5);
+        EXPECT_EQ(log.at(0).getTradeId(), 3 * perFile + 1);
+        EXPECT_EQ(log.getPath(), logPath);
+    }
+
+    TradeLog first(logPath + ".old", 4, reserved);
+    ASSERT_EQ(first.size(), perFile);
+    EXPECT_EQ(first.at(0).getTradeId(), 1);
+    TradeLog third(logPath + ".old.2", 4, reserved);
+    ASSERT_EQ(third.size(), perFile);
+    EXPECT_EQ(third.at(perFile - 1).getTradeId(), 3 * perFile);
+}
@@ -2,7 +2,9 @@
 #ifndef MATCHING_ENGINE_ID_GENERATOR_H
 #define MATCHING_ENGINE_ID_GENERATOR_H
 
+#include <algorithm>
 #include <atomic>
+#include <stdexcept>
 
 class IDGenerator
 {
@@ -49,4 +51,52 @@ private:
     std::atomic<unsigned int> clientIDCounter{};
 };
 
+// Order and trade IDs of one matching thread, so shards share no counter.
+// Shard shardIndex of 2^shardBits hands out (counter << shardBits) | shardIndex: IDs never collide across shards
+// and keep increasing within one. Plain counters, only the owning matching thread may call it.
+class ShardIDGenerator
+{
+public:
+    explicit ShardIDGenerator(const unsigned int shardIndex = 0, const unsigned int shardBits = 0)
+        : shardIndex(shardIndex), shardBits(shardBits)
+    {
+        if (shardBits >= 32 || shardIndex >> shardBits != 0)
+        {
+            throw std::invalid_argument("Shard index does not fit the shard bits of its IDs.");
+        }
+    }
+
+    auto getNextOrderID() -> unsigned int
+    {
+        return compose(orderCounter++);
+    }
+
+    auto getNextTradeID() -> unsigned int
+    {
+        return compose(tradeCounter++);
+    }
+
+    // Makes every later trade ID at least nextId, for a trade log continued from an earlier run
+    void advanceTradeIDs(const unsigned int nextId)
+    {
+        unsigned int counter = nextId >> shardBits;
+        if (compose(counter) < nextId)
+        {
+            ++counter;
+        }
+        tradeCounter = std::max(tradeCounter, counter);
+    }
+
+private:
+    unsigned int shardIndex;
+    unsigned int shardBits;
+    unsigned int orderCounter = 1;
+    unsigned int tradeCounter = 1;
+
+    [[nodiscard]] auto compose(const unsigned int counter) const -> unsigned int
+    {
+        return (counter << shardBits) | shardIndex;
+    }
+};
+
 #endif // MATCHING_ENGINE_ID_GENERATOR_H
\ No newline at end of file
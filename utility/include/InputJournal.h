@@ -0,0 +1,136 @@
+#ifndef INPUT_JOURNAL_H
+#define INPUT_JOURNAL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "InstrumentRegistry.hpp"
+#include "LogFileHeader.h"
+#include "MappedFile.h"
+#include "Message.hpp"
+#include "OrderType.h"
+#include "TickSize.hpp"
+#include "TimestampUtility.h"
+#include "utility_config.hpp"
+
+// When journal records are forced to disk
+enum class JournalSyncPolicy : std::uint8_t
+{
+    NONE,          // Never: the kernel writes the pages back on its own, a process crash loses nothing, power loss may
+    PERIODIC,      // A background thread msyncs whatever was committed every SYNC_INTERVAL_MS
+    GROUP_COMMIT   // A background thread msyncs every committed batch as soon as it sees it
+};
+
+auto parseJournalSyncPolicy(const std::string &name) -> JournalSyncPolicy;
+
+// One sequenced input message, enough to replay it against an empty engine
+struct alignas(64) JournalRecord
+{
+    std::uint64_t sequence;   // 1-based position in the journal
+    Timestamp timestamp;      // Gateway arrival, monotonicNow() ticks of the process that wrote it
+    Price price;              // Limit price of an add, new price of a modify
+    std::uint32_t orderId;    // ID assigned to an add, target of a modify or cancel
+    std::uint32_t clientId;
+    std::int32_t quantity;
+    InstrumentId instrument;
+    MessageType type;
+    OrderType orderType;
+    bool isBuy;
+};
+
+static_assert(sizeof(JournalRecord) == 64, "JournalRecord must fill exactly one cache line");
+
+// Write-ahead journal of the messages a matching thread handles, in a preallocated memory-mapped file.
+// The file is a 64-byte header followed by JournalRecords. The matching thread appends a record by copying it
+// into the mapping before the message is matched and commits once per batch by publishing the new record count,
+// neither of which makes a system call or takes a lock. A background thread forces the pages to disk according
+// to the JournalSyncPolicy, reporting how far the journal is durable through durableCount() and the durable
+// callback so acks can be held back until their batch is on disk, and doubles the file in place once it is
+// half full. Every journal starts a new file: the journal of an earlier run, whose order IDs the restarted
+// engine hands out again, is moved aside to <path>.old (see startNewLogFile) and can be read with readRecords.
+// A file that fills its reserved address space is moved aside the same way by the matching thread, which goes on
+// in a new file at path; sequence numbers continue across the files.
+class InputJournal
+{
+public:
+    explicit InputJournal(const std::string &path, JournalSyncPolicy policy = JournalSyncPolicy::PERIODIC,
+                          std::size_t initialCapacity = Utility_Config::Journal::INITIAL_CAPACITY,
+                          std::size_t reservedSize = Utility_Config::Mapping::RESERVED_BYTES);
+    // Syncs what was committed, except under NONE
+    ~InputJournal();
+
+    InputJournal(const InputJournal &) = delete;
+    auto operator=(const InputJournal &) -> InputJournal & = delete;
+
+    // Matching thread only. orderId is the ID assigned to an add, modify and cancel carry their own
+    void append(const Message &message, std::uint32_t orderId = 0);
+    // Makes every appended record part of the journal, returns the committed record count
+    auto commit() -> std::uint64_t;
+
+    // Committed records
+    [[nodiscard]] auto size() const -> std::size_t;
+    // Committed records known to be on disk
+    [[nodiscard]] auto durableCount() const -> std::uint64_t;
+    // Committed record of the current file, throws std::out_of_range for one rolled over to an earlier file
+    [[nodiscard]] auto at(std::size_t index) const -> const JournalRecord &;
+    [[nodiscard]] auto getPolicy() const -> JournalSyncPolicy;
+    [[nodiscard]] auto getPath() const -> const std::string &;
+
+    // Called on the syncer thread with the new durableCount after every sync; set it before the first commit
+    void setDurableCallback(std::function<void(std::uint64_t)> callback);
+    // msyncs every committed record now, on the calling thread
+    void sync();
+
+    // The message a record was made from, for replay; the ID assigned to an add is only in the record
+    static auto toMessage(const JournalRecord &record) -> Message;
+    // Committed records of the journal file at path, throws if it is not a journal of this layout
+    static auto readRecords(const std::string &path) -> std::vector<JournalRecord>;
+
+private:
+    using Header = LogFileHeader;
+
+    std::string path;
+    std::size_t initialCapacity;
+    std::size_t reservedSize;
+    // Replaced by the matching thread under syncMutex when it rolls over, the syncer only uses it under syncMutex
+    std::unique_ptr<MappedFile> file;
+    JournalSyncPolicy policy;
+    // Serialises syncs, growing ahead and the durable callback; the matching thread only takes it to roll over
+    std::mutex syncMutex;
+
+    std::uint64_t appended;             // Matching thread only
+    std::uint64_t fileStart = 0;        // Records in earlier files, written like file
+    std::atomic<std::uint64_t> committed;
+    std::atomic<std::uint64_t> durable;
+
+    std::function<void(std::uint64_t)> durableCallback;
+    std::atomic<bool> running{false};
+    std::thread syncer;
+
+    [[nodiscard]] auto header() const -> Header *;
+    [[nodiscard]] auto records() const -> JournalRecord *;
+    [[nodiscard]] auto capacity() const -> std::size_t;
+    // File size holding twice the current capacity, within the reservation
+    [[nodiscard]] auto doubledSize() const -> std::size_t;
+
+    void startHeader();
+    // Called by the matching thread with the file full: grows it, or rolls over once it cannot grow any further
+    void makeRoom();
+    void rollOver();
+
+    void syncLoop();
+    // msyncs the records committed since the last sync, returns the durable count
+    auto syncCommitted() -> std::uint64_t;
+    // syncCommitted with syncMutex held
+    auto syncLocked() -> std::uint64_t;
+    // Doubles the file once the committed records fill half of it
+    void growAhead();
+};
+
+#endif // INPUT_JOURNAL_H
@@ -0,0 +1,195 @@
+#ifndef INSTRUMENT_REGISTRY_HPP
+#define INSTRUMENT_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include "TickSize.hpp"
+#include "utility_config.hpp"
+
+// Small dense integer standing for an instrument symbol inside the system
+using InstrumentId = std::uint16_t;
+
+// Interns instrument symbols into InstrumentIds and keeps each instrument's tick size.
+// Symbols are resolved once at the edge (protocol parsing, book creation); everything past that point carries
+// the ID. Lookups by ID are lock-free: entries are never moved or removed, and the entry count is published
+// after an entry is filled in.
+class InstrumentRegistry
+{
+public:
+    static constexpr InstrumentId INVALID_ID = std::numeric_limits<InstrumentId>::max();
+    static constexpr std::size_t MAX_INSTRUMENTS = Utility_Config::Instrument::MAX_INSTRUMENTS;
+
+    // Obtain singleton instance
+    static auto getInstance() -> InstrumentRegistry &
+    {
+        static InstrumentRegistry instance;
+        return instance;
+    }
+
+    // Prohibit copy and assignment
+    InstrumentRegistry(const InstrumentRegistry &) = delete;
+    auto operator=(const InstrumentRegistry &) -> InstrumentRegistry & = delete;
+
+    // Return the ID of symbol, assigning the next free one on first use. Registering again updates the tick size,
+    // unless the instrument has an order book: its resting prices are in ticks of the old size, so that throws.
+    auto registerInstrument(const std::string &symbol,
+                            const double tickSize = Utility_Config::Tick::DEFAULT_TICK_SIZE) -> InstrumentId
+    {
+        validate(symbol, tickSize);
+        std::unique_lock lock(mutex);
+        return registerLocked(symbol, tickSize);
+    }
+
+    // Registers symbol like registerInstrument and counts one more order book of it, for the engines.
+    // Throws if another book of the instrument uses a different tick size.
+    auto attachBook(const std::string &symbol, const double tickSize) -> InstrumentId
+    {
+        validate(symbol, tickSize);
+        std::unique_lock lock(mutex);
+        const InstrumentId id = registerLocked(symbol, tickSize);
+        ++entries[id].bookCount;
+        return id;
+    }
+
+    // A book counted by attachBook is gone
+    void detachBook(const InstrumentId id)
+    {
+        std::unique_lock lock(mutex);
+        if (contains(id) && entries[id].bookCount > 0)
+        {
+            --entries[id].bookCount;
+        }
+    }
+
+    // INVALID_ID if the symbol was never registered
+    [[nodiscard]] auto find(const std::string &symbol) const -> InstrumentId
+    {
+        std::shared_lock lock(mutex);
+        const auto iter = symbolToId.find(symbol);
+        return (iter != symbolToId.end()) ? iter->second : INVALID_ID;
+    }
+
+    [[nodiscard]] auto resolve(const std::string &symbol) const -> InstrumentId
+    {
+        const InstrumentId id = find(symbol);
+        if (id == INVALID_ID)
+        {
+            throw std::invalid_argument("Unknown instrument: " + symbol);
+        }
+        return id;
+    }
+
+    [[nodiscard]] auto contains(const InstrumentId id) const -> bool
+    {
+        return id < entryCount.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] auto getSymbol(const InstrumentId id) const -> const std::string &
+    {
+        return entry(id).symbol;
+    }
+
+    [[nodiscard]] auto getTickSize(const InstrumentId id) const -> double
+    {
+        return entry(id).tickSize.load(std::memory_order_relaxed);
+    }
+
+    // Convert a decimal price into ticks, rejecting prices that are not on the tick grid
+    [[nodiscard]] auto toTicks(const InstrumentId id, const double price) const -> Price
+    {
+        const double tickSize = getTickSize(id);
+        const double ticks = std::round(price / tickSize);
+        if (std::fabs(ticks * tickSize - price) > tickSize * Utility_Config::Tick::TICK_TOLERANCE)
+        {
+            throw std::invalid_argument("Price is not a multiple of the tick size.");
+        }
+        return static_cast<Price>(ticks);
+    }
+
+    [[nodiscard]] auto toDouble(const InstrumentId id, const Price ticks) const -> double
+    {
+        return static_cast<double>(ticks) * getTickSize(id);
+    }
+
+    [[nodiscard]] auto size() const -> std::size_t
+    {
+        return entryCount.load(std::memory_order_acquire);
+    }
+
+private:
+    InstrumentRegistry() = default;
+
+    struct Entry
+    {
+        std::string symbol;
+        std::atomic<double> tickSize{Utility_Config::Tick::DEFAULT_TICK_SIZE};
+        std::size_t bookCount = 0;  // Guarded by mutex
+    };
+
+    static void validate(const std::string &symbol, const double tickSize)
+    {
+        if (symbol.empty())
+        {
+            throw std::invalid_argument("Instrument symbol cannot be empty.");
+        }
+        if (!(tickSize > 0.0))
+        {
+            throw std::invalid_argument("Tick size must be greater than zero.");
+        }
+    }
+
+    // Caller holds the unique lock
+    auto registerLocked(const std::string &symbol, const double tickSize) -> InstrumentId
+    {
+        if (const auto iter = symbolToId.find(symbol); iter != symbolToId.end())
+        {
+            Entry &existing = entries[iter->second];
+            if (existing.tickSize.load(std::memory_order_relaxed) != tickSize)
+            {
+                if (existing.bookCount > 0)
+                {
+                    throw std::invalid_argument("Cannot change the tick size of " + symbol + " while it has an order book.");
+                }
+                existing.tickSize.store(tickSize, std::memory_order_relaxed);
+            }
+            return iter->second;
+        }
+
+        const std::size_t count = entryCount.load(std::memory_order_relaxed);
+        if (count == MAX_INSTRUMENTS)
+        {
+            throw std::length_error("Instrument registry is full.");
+        }
+        const auto id = static_cast<InstrumentId>(count);
+        entries[id].symbol = symbol;
+        entries[id].tickSize.store(tickSize, std::memory_order_relaxed);
+        symbolToId.emplace(symbol, id);
+        entryCount.store(count + 1, std::memory_order_release);
+        return id;
+    }
+
+    [[nodiscard]] auto entry(const InstrumentId id) const -> const Entry &
+    {
+        if (!contains(id))
+        {
+            throw std::out_of_range("Unknown instrument id: " + std::to_string(id));
+        }
+        return entries[id];
+    }
+
+    mutable std::shared_mutex mutex;  // Guards registration and symbolToId
+    std::unordered_map<std::string, InstrumentId> symbolToId;
+    std::array<Entry, MAX_INSTRUMENTS> entries;
+    std::atomic<std::size_t> entryCount{0};
+};
+
+#endif // INSTRUMENT_REGISTRY_HPP
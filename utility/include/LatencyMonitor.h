@@ -0,0 +1,108 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utility_config.hpp"
+
+// Segments of an order message's trip through the system
+enum class LatencyStage : std::uint8_t
+{
+    QUEUE_WAIT,  // Gateway read -> matching thread starts on it
+    MATCH,       // Processing by the OrderManager and MatchingEngine
+    ACK,         // Processing done -> acknowledgement handed to the socket
+    END_TO_END,  // Gateway read -> acknowledgement handed to the socket
+    COUNT
+};
+
+auto latencyStageName(LatencyStage stage) -> const char *;
+
+// Log-linear histogram in the style of HdrHistogram: every power of two is split into 2^SUB_BUCKET_BITS
+// linear buckets, so any value is stored with a relative error below 2^-SUB_BUCKET_BITS in constant space.
+// One thread records, any thread may read or merge concurrently: counters are relaxed atomics.
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned int SUB_BUCKET_BITS = Utility_Config::Latency::SUB_BUCKET_BITS;
+    static constexpr std::size_t SUB_BUCKET_COUNT = std::size_t{1} << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    void record(std::uint64_t value);
+    void merge(const LatencyHistogram &other);
+    void reset();
+
+    [[nodiscard]] auto count() const -> std::uint64_t;
+    [[nodiscard]] auto max() const -> std::uint64_t;
+    // Smallest recorded value v such that percentile % of the values are <= v, within the bucket precision
+    [[nodiscard]] auto valueAtPercentile(double percentile) const -> std::uint64_t;
+
+    static auto bucketIndex(std::uint64_t value) -> std::size_t;
+    // Largest value falling into bucket index
+    static auto bucketUpperBound(std::size_t index) -> std::uint64_t;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+    std::atomic<std::uint64_t> total{0};
+    std::atomic<std::uint64_t> maxValue{0};
+};
+
+struct LatencySummary
+{
+    std::uint64_t count = 0;
+    double p50 = 0;   // nanoseconds
+    double p99 = 0;
+    double p999 = 0;
+    double max = 0;
+};
+
+// Process-wide latency recorder.
+// Timestamps are raw ticks of the process clock (see monotonicNow in TimestampUtility.h), the same readings the
+// gateway stamps on messages; ticks are turned into nanoseconds only when a report is made.
+// Every recording thread gets its own set of histograms on first use, so recording takes no lock and
+// shares no cache line; reports merge the per-thread histograms.
+class LatencyMonitor
+{
+public:
+    static auto getInstance() -> LatencyMonitor &;
+
+    LatencyMonitor(const LatencyMonitor &) = delete;
+    auto operator=(const LatencyMonitor &) -> LatencyMonitor & = delete;
+
+    // Current monotonicNow() reading, never 0
+    static auto now() -> std::uint64_t;
+
+    // Record end - start for stage on the calling thread, a start of 0 means the message was not stamped
+    void record(LatencyStage stage, std::uint64_t start, std::uint64_t end);
+
+    // Histogram of stage across all threads, in ticks
+    [[nodiscard]] auto merged(LatencyStage stage) const -> std::unique_ptr<LatencyHistogram>;
+    [[nodiscard]] auto summary(LatencyStage stage) const -> LatencySummary;
+    // One line per stage with count, p50, p99, p99.9 and max in microseconds
+    [[nodiscard]] auto report() const -> std::string;
+
+    [[nodiscard]] auto ticksToNanoseconds(std::uint64_t ticks) const -> double;
+
+    // Clears every histogram; values recorded while it runs may be lost
+    void reset();
+
+private:
+    using StageHistograms = std::array<LatencyHistogram, static_cast<std::size_t>(LatencyStage::COUNT)>;
+
+    LatencyMonitor();
+
+    auto localHistograms() -> StageHistograms &;
+
+    // Histograms of the calling thread, owned by threadHistograms
+    static thread_local StageHistograms *local;
+
+    mutable std::mutex threadsMutex;
+    std::vector<std::unique_ptr<StageHistograms>> threadHistograms;
+};
+
+#endif // LATENCY_MONITOR_H
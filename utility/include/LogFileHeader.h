@@ -0,0 +1,26 @@
+#ifndef LOG_FILE_HEADER_H
+#define LOG_FILE_HEADER_H
+
+#include <cstdint>
+#include <string>
+
+// First 64 bytes of the append-only record files, the trade log and the input journal
+struct alignas(64) LogFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint64_t recordCount;
+};
+
+// Readies path to be opened as a log with this magic, version and record size. An existing file that is not
+// such a log (another format, an older layout, a truncated log) is renamed aside to <path>.old, or .old.<n> if
+// that is taken, with a logged warning, so the caller starts a new log instead of failing or overwriting it.
+// Returns path.
+auto prepareLogFile(const std::string &path, const char (&magic)[8], std::uint32_t version,
+                    std::uint32_t recordSize) -> const std::string &;
+
+// Renames a non-empty file at path aside the same way, logging why, so a new log starts there. Returns path.
+auto startNewLogFile(const std::string &path, const std::string &reason) -> const std::string &;
+
+#endif // LOG_FILE_HEADER_H
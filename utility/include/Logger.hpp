@@ -6,6 +6,7 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "utility_config.hpp"
 
@@ -17,13 +18,19 @@ public:
         
         auto logger = spdlog::get(name);
         if (!logger) {
-            logger = createLogger(name, toConsole);
+            // Several matching threads may ask for the same logger first, only one of them creates it
+            std::lock_guard<std::mutex> lock(create_mutex_);
+            logger = spdlog::get(name);
+            if (!logger) {
+                logger = createLogger(name, toConsole);
+            }
         }
         return logger;
     }
 
 private:
     static inline std::once_flag init_flag_;
+    static inline std::mutex create_mutex_;
 
     static void initializeThreadPool() {
         spdlog::init_thread_pool(Utility_Config::Logging::LOG_QUEUE_SIZE, Utility_Config::Logging::LOG_THREADS);
@@ -0,0 +1,54 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include "utility_config.hpp"
+
+// Read-write shared memory mapping of a whole file.
+// The file is created if needed and its blocks are reserved up front, so writing into the mapping never
+// hits a sparse hole or runs out of disk halfway. The address range for reservedSize bytes is reserved once,
+// so the mapping never moves: resize() extends it in place, pointers into it stay valid, and other threads
+// may keep reading and writing the mapped part while one thread resizes. Only resize() and sync() make
+// system calls.
+class MappedFile
+{
+public:
+    // Opens or creates path and maps at least minimumSize bytes; an existing larger file keeps its size
+    MappedFile(std::string path, std::size_t minimumSize,
+               std::size_t reservedSize = Utility_Config::Mapping::RESERVED_BYTES);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    auto operator=(const MappedFile &) -> MappedFile & = delete;
+
+    // Grows (or shrinks) the file and its mapping. Throws std::length_error past the reserved size; on any
+    // failure the file stays mapped at its previous size.
+    void resize(std::size_t newSize);
+    // resize() unless the file is already at least minimumSize bytes, safe to race with other calls
+    void grow(std::size_t minimumSize);
+    // msync the mapping to disk, waiting for completion unless async
+    void sync(bool async = false) const;
+    // msync only the pages holding bytes [offset, offset + length)
+    void sync(std::size_t offset, std::size_t length, bool async = false) const;
+
+    [[nodiscard]] auto data() const -> char *;
+    [[nodiscard]] auto size() const -> std::size_t;
+    // The most the file can grow to
+    [[nodiscard]] auto getReservedSize() const -> std::size_t;
+    [[nodiscard]] auto getPath() const -> const std::string &;
+
+private:
+    std::string path;
+    int fd = -1;
+    char *mapping = nullptr;            // Start of the reserved range, fixed for the object's lifetime
+    std::size_t reservedSize = 0;
+    std::atomic<std::size_t> mappedSize{0};
+    std::mutex resizeMutex;
+
+    void resizeLocked(std::size_t newSize);
+};
+
+#endif // MAPPED_FILE_H
@@ -2,10 +2,13 @@
 #define MESSAGE_HPP
 
 #include <iomanip>
+#include <memory>
 #include <string>
 #include <sstream>
 
+#include "InstrumentRegistry.hpp"
 #include "OrderType.h"
+#include "TickSize.hpp"
 #include "TimestampUtility.h"
 
 // Messages Type
@@ -18,14 +21,14 @@ enum class MessageType : std::uint8_t {
 
 // Details for AddOrder
 struct AddOrderDetails {
-    std::string instrument;
-    double price;
+    InstrumentId instrument;
+    Price price;            // in ticks
     int quantity;
     bool isBuy;
     OrderType type;
 
-    AddOrderDetails(std::string  instr, const double p, const int qty, const bool buy, const OrderType orderType)
-        : instrument(std::move(instr)), price(p), quantity(qty), isBuy(buy), type(orderType) {}
+    AddOrderDetails(const InstrumentId instr, const Price p, const int qty, const bool buy, const OrderType orderType)
+        : instrument(instr), price(p), quantity(qty), isBuy(buy), type(orderType) {}
 
     [[nodiscard]] auto toString(const std::string& format = "default") const -> std::string;
 };
@@ -33,12 +36,12 @@ struct AddOrderDetails {
 // Details for ModifyOrder
 struct ModifyOrderDetails {
     unsigned int orderId;
-    std::string instrument;
-    double newPrice;
+    InstrumentId instrument;
+    Price newPrice;         // in ticks
     int newQuantity;
 
-    ModifyOrderDetails(const unsigned int id, std::string instrument, const double price, const int qty)
-        : orderId(id), instrument(std::move(instrument)), newPrice(price), newQuantity(qty) {}
+    ModifyOrderDetails(const unsigned int id, const InstrumentId instrument, const Price price, const int qty)
+        : orderId(id), instrument(instrument), newPrice(price), newQuantity(qty) {}
     [[nodiscard]] auto toString(const std::string& format = "default") const -> std::string;
 
 };
@@ -46,9 +49,9 @@ struct ModifyOrderDetails {
 // Details for Cancel Order
 struct CancelOrderDetails {
     unsigned int orderId;
-    std::string instrument;
+    InstrumentId instrument;
 
-    CancelOrderDetails(const unsigned int id, std::string instrument) : orderId(id), instrument(std::move(instrument)) {}
+    CancelOrderDetails(const unsigned int id, const InstrumentId instrument) : orderId(id), instrument(instrument) {}
     [[nodiscard]] auto toString(const std::string& format = "default") const -> std::string;
 
 };
@@ -56,28 +59,42 @@ struct CancelOrderDetails {
 struct Message {
     MessageType type = MessageType::UNDEFINED;
     unsigned int client_id{};
-    std::chrono::system_clock::time_point time;
+    Timestamp timestamp = 0; // monotonicNow() when the gateway read the message, 0 if not stamped
+    std::uint32_t traceId = 0; // OrderTracer ID of a sampled message, 0 if it is not traced
     std::unique_ptr<AddOrderDetails> addOrderDetails;
     std::unique_ptr<ModifyOrderDetails> modifyDetails;
     std::unique_ptr<CancelOrderDetails> cancelDetails;
 
+    // Instrument the message refers to, InstrumentRegistry::INVALID_ID if it carries no details
+    [[nodiscard]] auto getInstrument() const -> InstrumentId {
+        if (addOrderDetails) {
+            return addOrderDetails->instrument;
+        }
+        if (modifyDetails) {
+            return modifyDetails->instrument;
+        }
+        if (cancelDetails) {
+            return cancelDetails->instrument;
+        }
+        return InstrumentRegistry::INVALID_ID;
+    }
+
     // Factory methods to create different kinds of messages
-    static auto createAddOrderMessage(const std::string& instrument, double price, int quantity, bool isBuy, OrderType type) -> Message {
+    static auto createAddOrderMessage(const InstrumentId instrument, Price price, int quantity, bool isBuy, OrderType type) -> Message {
         Message msg;
         msg.type = MessageType::ADD_ORDER;
         msg.addOrderDetails = std::make_unique<AddOrderDetails>(instrument, price, quantity, isBuy, type);
-        msg.time = currentTimestamp();
         return msg;
     }
 
-    static auto createModifyOrderMessage(unsigned int orderId, const std::string& instrument, double newPrice, int newQuantity) -> Message {
+    static auto createModifyOrderMessage(unsigned int orderId, const InstrumentId instrument, Price newPrice, int newQuantity) -> Message {
         Message msg;
         msg.type = MessageType::MODIFY_ORDER;
         msg.modifyDetails = std::make_unique<ModifyOrderDetails>(orderId, instrument, newPrice, newQuantity);
         return msg;
     }
 
-    static auto createCancelOrderMessage(unsigned int orderId, const std::string& instrument) -> Message {
+    static auto createCancelOrderMessage(unsigned int orderId, const InstrumentId instrument) -> Message {
         Message msg;
         msg.type = MessageType::CANCEL_ORDER;
         msg.cancelDetails = std::make_unique<CancelOrderDetails>(orderId, instrument);
@@ -87,24 +104,27 @@ struct Message {
 
 inline auto AddOrderDetails::toString(const std::string& format) const -> std::string {
     std::ostringstream oss;
+    const InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    const std::string &symbol = registry.getSymbol(instrument);
+    const double displayPrice = registry.toDouble(instrument, price);
 
     if (format == "default") {
-        oss << "Instrument: " << instrument << ", "
-            << "Price: " << std::fixed << std::setprecision(2) << price << ", "
+        oss << "Instrument: " << symbol << ", "
+            << "Price: " << std::fixed << std::setprecision(2) << displayPrice << ", "
             << "Quantity: " << quantity << ", "
             << "IsBuy: " << (isBuy ? "Buy" : "Sell") << ", "
             << "OrderType: " << static_cast<int>(type);
     } else if (format == "json") {
         oss << "{"
-            << R"("Instrument":")" << instrument << R"(",)"
-            << R"("Price":)" << std::fixed << std::setprecision(2) << price << ","
+            << R"("Instrument":")" << symbol << R"(",)"
+            << R"("Price":)" << std::fixed << std::setprecision(2) << displayPrice << ","
             << R"("Quantity":)" << quantity << ","
             << R"("IsBuy":)" << (isBuy ? "true" : "false") << ","
             << R"("OrderType":)" << static_cast<int>(type)
             << "}";
     } else if (format == "csv") {
-        oss << instrument << ","
-            << std::fixed << std::setprecision(2) << price << ","
+        oss << symbol << ","
+            << std::fixed << std::setprecision(2) << displayPrice << ","
             << quantity << ","
             << (isBuy ? "Buy" : "Sell") << ","
             << static_cast<int>(type);
@@ -117,23 +137,26 @@ inline auto AddOrderDetails::toString(const std::string& format) const -> std::s
 
 inline auto ModifyOrderDetails::toString(const std::string& format) const -> std::string {
     std::ostringstream oss;
+    const InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    const std::string &symbol = registry.getSymbol(instrument);
+    const double displayPrice = registry.toDouble(instrument, newPrice);
 
     if (format == "default") {
         oss << "OrderID: " << orderId << ", "
-            << "Instrument: " << instrument << ", "
-            << "NewPrice: " << std::fixed << std::setprecision(2) << newPrice << ", "
+            << "Instrument: " << symbol << ", "
+            << "NewPrice: " << std::fixed << std::setprecision(2) << displayPrice << ", "
             << "NewQuantity: " << newQuantity;
     } else if (format == "json") {
         oss << "{"
             << R"("OrderID":)" << orderId << ","
-            << R"("Instrument":")" << instrument << R"(",)"
-            << R"("NewPrice":)" << std::fixed << std::setprecision(2) << newPrice << ","
+            << R"("Instrument":")" << symbol << R"(",)"
+            << R"("NewPrice":)" << std::fixed << std::setprecision(2) << displayPrice << ","
             << R"("NewQuantity":)" << newQuantity
             << "}";
     } else if (format == "csv") {
         oss << orderId << ","
-            << instrument << ","
-            << std::fixed << std::setprecision(2) << newPrice << ","
+            << symbol << ","
+            << std::fixed << std::setprecision(2) << displayPrice << ","
             << newQuantity;
     } else {
         throw std::invalid_argument("Unsupported format: " + format);
@@ -144,18 +167,19 @@ inline auto ModifyOrderDetails::toString(const std::string& format) const -> std
 
 inline auto CancelOrderDetails::toString(const std::string& format) const -> std::string {
     std::ostringstream oss;
+    const std::string &symbol = InstrumentRegistry::getInstance().getSymbol(instrument);
 
     if (format == "default") {
         oss << "OrderID: " << orderId << ", "
-            << "Instrument: " << instrument;
+            << "Instrument: " << symbol;
     } else if (format == "json") {
         oss << "{"
             << R"("OrderID":)" << orderId << ","
-            << R"("Instrument":")" << instrument << R"(")"
+            << R"("Instrument":")" << symbol << R"(")"
             << "}";
     } else if (format == "csv") {
         oss << orderId << ","
-            << instrument;
+            << symbol;
     } else {
         throw std::invalid_argument("Unsupported format: " + format);
     }
@@ -1,14 +1,45 @@
 #ifndef ORDER_QUEUE_H
 #define ORDER_QUEUE_H
 
-#include <queue>
-#include <chrono>
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "Message.hpp"
+#include "utility_config.hpp"
 
+// Bounded lock-free ring buffer of Messages with a single consumer.
+// Each slot carries a sequence number telling whether it is free for the producer at a given position or holds
+// the message the consumer expects there, so a hand-off is one slot write plus one release store, with no lock.
+// SINGLE producer mode claims positions with a plain store, MULTI producer mode (several gateways) with a CAS.
+// How the consumer waits on an empty queue is chosen by its WaitStrategy; producers only touch the park mutex when
+// the strategy can park and the consumer is actually parked.
 class MessageQueue {
 public:
-    MessageQueue();
+    enum class ProducerMode {
+        SINGLE,
+        MULTI
+    };
+
+    enum class WaitStrategy {
+        BUSY_SPIN,   // Poll with a pause instruction, never gives up the core
+        SPIN_YIELD,  // Poll, then yield the time slice between polls
+        SPIN_PARK,   // Poll, then sleep on a condition variable until a producer wakes it
+        BLOCKING     // Sleep on the condition variable as soon as the queue is empty
+    };
+
+    // Accepts busy_spin, spin_yield, spin_park and blocking
+    static auto parseWaitStrategy(const std::string& name) -> WaitStrategy;
+
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    // capacity is rounded up to a power of two
+    explicit MessageQueue(std::size_t capacity = Utility_Config::MessageQueue::DEFAULT_CAPACITY,
+                          ProducerMode producerMode = ProducerMode::MULTI,
+                          WaitStrategy waitStrategy = WaitStrategy::SPIN_PARK);
     ~MessageQueue();
 
     MessageQueue(const MessageQueue&) = delete;
@@ -17,20 +48,52 @@ public:
     MessageQueue(MessageQueue&&) = delete;
     auto operator=(MessageQueue&&) -> MessageQueue& = delete;
 
+    // Waits for a free slot while the queue is full, throws if it is full and shut down
     void push(Message&& msg);
+    // Returns false and leaves msg untouched if the queue is full
+    bool tryPush(Message&& msg);
+    // Blocks until a message arrives, returns false once the queue is shut down and drained
     bool pop(Message& msg);
     bool tryPop(Message& msg);
+    // Waits like pop for the first message, then moves out whatever else is ready, up to maxCount in total.
+    // Replaces the contents of batch, returns 0 once the queue is shut down and drained
+    size_t popBatch(std::vector<Message>& batch, size_t maxCount);
+    // Non-blocking popBatch
+    size_t drain(std::vector<Message>& batch, size_t maxCount);
     bool empty() const;
     size_t size() const;
+    size_t capacity() const;
+    WaitStrategy getWaitStrategy() const;
 
     void shutdown();
     bool isShutdown() const;
 
 private:
-    mutable std::mutex m_mutex;
-    std::condition_variable m_condVar;
-    std::queue<Message> m_queue;
-    bool m_shutdown = false;
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<std::size_t> sequence{0};
+        Message message;
+    };
+
+    const std::size_t m_capacity;
+    const std::size_t m_mask;
+    const ProducerMode m_producerMode;
+    const WaitStrategy m_waitStrategy;
+    const bool m_canPark;
+    std::unique_ptr<Slot[]> m_slots;
+
+    // Producer and consumer positions live on their own cache lines
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_enqueuePos{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> m_dequeuePos{0};
+
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> m_shutdown{false};
+    std::atomic<bool> m_consumerParked{false};
+    std::mutex m_parkMutex;
+    std::condition_variable m_parkCondVar;
+
+    size_t takeReady(std::vector<Message>& batch, size_t maxCount);
+    bool hasMessage() const;
+    void parkConsumer();
+    void wakeConsumer();
 };
 
 #endif // ORDER_QUEUE_H
@@ -0,0 +1,47 @@
+#ifndef MESSAGE_ROUTER_HPP
+#define MESSAGE_ROUTER_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "InstrumentRegistry.hpp"
+#include "Message.hpp"
+#include "MessageQueue.h"
+
+// Routes inbound messages to the queue of the matching shard owning their instrument.
+// An instrument always maps to the same queue, so messages of one instrument keep their arrival order.
+class MessageRouter
+{
+public:
+    explicit MessageRouter(MessageQueue &queue) : queues{&queue} {}
+
+    explicit MessageRouter(std::vector<MessageQueue *> shardQueues) : queues(std::move(shardQueues))
+    {
+        if (queues.empty())
+        {
+            throw std::invalid_argument("MessageRouter needs at least one queue.");
+        }
+    }
+
+    static auto shardOf(const InstrumentId instrument, const std::size_t shardCount) -> std::size_t
+    {
+        // Messages without an instrument are rejected downstream, they all go to the first shard
+        return instrument == InstrumentRegistry::INVALID_ID ? 0 : instrument % shardCount;
+    }
+
+    void route(Message &&message)
+    {
+        queues[shardOf(message.getInstrument(), queues.size())]->push(std::move(message));
+    }
+
+    [[nodiscard]] auto getShardCount() const -> std::size_t
+    {
+        return queues.size();
+    }
+
+private:
+    std::vector<MessageQueue *> queues;
+};
+
+#endif // MESSAGE_ROUTER_HPP
@@ -0,0 +1,109 @@
+#ifndef ORDER_TRACER_H
+#define ORDER_TRACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "TimestampUtility.h"
+#include "utility_config.hpp"
+
+// Points of an order message's trip the tracer stamps, in path order
+enum class TraceStage : std::uint8_t
+{
+    GATEWAY_READ,  // TCPGateway::receive, before parsing
+    QUEUE_PUSH,    // Handed to MessageQueue::push
+    DEQUEUE,       // OrderManager::processLoop starts on it
+    MATCH_BEGIN,   // MatchingEngine::processNewOrder called
+    MATCH_END,     // MatchingEngine::processNewOrder returned
+    ACK_QUEUED,    // Ack handed to TCPGateway::queueMessagesToSend
+    ACK_WRITTEN,   // Ack handed to uv_write on the event loop
+    COUNT
+};
+
+auto traceStageName(TraceStage stage) -> const char *;
+
+// Sampling tracer of individual orders.
+// The gateway gives one message in sampleInterval a trace ID, which travels in the Message and the ack;
+// every stage stamps (trace ID, stage, monotonicNow()) for traced messages only, so an untraced message
+// costs a compare per stage. Each thread writes into its own fixed ring of events (oldest overwritten),
+// registered on first use like the LatencyMonitor histograms. writeChromeTrace turns the events into one
+// span per stage and order in the Chrome trace event format, viewable in chrome://tracing and Perfetto.
+class OrderTracer
+{
+public:
+    static auto getInstance() -> OrderTracer &;
+
+    OrderTracer(const OrderTracer &) = delete;
+    auto operator=(const OrderTracer &) -> OrderTracer & = delete;
+
+    // Trace one message in interval, 0 turns sampling off
+    void setSampleInterval(std::uint32_t interval);
+    [[nodiscard]] auto getSampleInterval() const -> std::uint32_t;
+
+    // Trace ID for the next inbound message, 0 when it is not sampled
+    auto sample() -> std::uint32_t;
+
+    void record(const std::uint32_t traceId, const TraceStage stage)
+    {
+        if (traceId != 0)
+        {
+            recordSampled(traceId, stage, monotonicNow());
+        }
+    }
+
+    // Chrome trace JSON of every buffered event, returns the number of events written besides thread names
+    auto writeChromeTrace(std::ostream &out) const -> std::size_t;
+    // Same, to a file, throws std::runtime_error if it cannot be written
+    auto dump(const std::string &path) const -> std::size_t;
+
+    // Drops every buffered event; events recorded while it runs may survive
+    void reset();
+
+private:
+    struct TraceEvent
+    {
+        Timestamp timestamp;
+        std::uint32_t traceId;
+        TraceStage stage;
+        std::size_t thread;  // Index of the recording thread's buffer
+    };
+
+    // Single writer ring; readers copy events and drop any the writer may have overwritten meanwhile
+    struct ThreadBuffer
+    {
+        struct Slot
+        {
+            std::atomic<Timestamp> timestamp{0};
+            std::atomic<std::uint64_t> tag{0};  // traceId << 8 | stage
+        };
+
+        static constexpr std::size_t CAPACITY = Utility_Config::Tracing::BUFFER_EVENTS;
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "The trace buffer capacity must be a power of two");
+
+        Slot slots[CAPACITY];
+        std::atomic<std::uint64_t> written{0};
+    };
+
+    OrderTracer() = default;
+
+    void recordSampled(std::uint32_t traceId, TraceStage stage, Timestamp timestamp);
+    auto localBuffer() -> ThreadBuffer &;
+    [[nodiscard]] auto collect() const -> std::vector<TraceEvent>;
+
+    static thread_local ThreadBuffer *local;
+    // Messages the calling thread still lets through before sampling the next one
+    static thread_local std::uint32_t countdown;
+
+    std::atomic<std::uint32_t> sampleInterval{Utility_Config::Tracing::DEFAULT_SAMPLE_INTERVAL};
+    std::atomic<std::uint32_t> nextTraceId{1};
+
+    mutable std::mutex threadsMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> threadBuffers;
+};
+
+#endif // ORDER_TRACER_H
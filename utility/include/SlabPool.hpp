@@ -0,0 +1,138 @@
+#ifndef SLAB_POOL_HPP
+#define SLAB_POOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Allocation counters and memory footprint of a pool
+struct SlabPoolStats
+{
+    std::size_t chunkCount = 0;      // Number of chunk allocations made so far
+    std::size_t capacity = 0;        // Objects that fit in all chunks
+    std::size_t inUse = 0;           // Objects currently handed out
+    std::size_t peakInUse = 0;       // Highest inUse ever observed
+    std::size_t acquireCount = 0;    // Total number of acquire calls
+    std::size_t releaseCount = 0;    // Total number of release calls
+    std::size_t footprintBytes = 0;  // Bytes held by the chunks
+};
+
+// Fixed-size object pool carving objects out of large cache-line aligned chunks.
+// Free objects are chained through an intrusive free list stored in the object memory itself,
+// so acquire/release are O(1) pointer swaps and a refill is a single chunk allocation.
+// The pool is not thread-safe, every OrderBook owns its own pools.
+template <typename T>
+class SlabPool
+{
+public:
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    explicit SlabPool(const std::size_t objectsPerChunk, const std::size_t initialChunks = 1)
+        : objectsPerChunk(objectsPerChunk)
+    {
+        if (objectsPerChunk == 0)
+        {
+            throw std::invalid_argument("SlabPool chunk must hold at least one object.");
+        }
+        for (std::size_t i = 0; i < initialChunks; ++i)
+        {
+            grow();
+        }
+    }
+
+    // Objects still in use when the pool is destroyed are not destructed, only their memory is freed
+    ~SlabPool()
+    {
+        for (Slot *chunk : chunks)
+        {
+            ::operator delete(chunk, std::align_val_t{CHUNK_ALIGNMENT});
+        }
+    }
+
+    SlabPool(const SlabPool &) = delete;
+    auto operator=(const SlabPool &) -> SlabPool & = delete;
+
+    template <typename... Args>
+    auto acquire(Args &&...args) -> T *
+    {
+        if (freeList == nullptr)
+        {
+            grow();
+        }
+        Slot *slot = freeList;
+        Slot *next = slot->next;
+
+        T *object;
+        try
+        {
+            object = new (slot->storage) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            // The constructor may have written over the link, the slot stays at the head of the free list
+            slot->next = next;
+            throw;
+        }
+        freeList = next;
+
+        ++stats.acquireCount;
+        if (++stats.inUse > stats.peakInUse)
+        {
+            stats.peakInUse = stats.inUse;
+        }
+        return object;
+    }
+
+    void release(T *object)
+    {
+        object->~T();
+        auto *slot = reinterpret_cast<Slot *>(object);
+        slot->next = freeList;
+        freeList = slot;
+
+        ++stats.releaseCount;
+        --stats.inUse;
+    }
+
+    [[nodiscard]] auto getStats() const -> const SlabPoolStats &
+    {
+        return stats;
+    }
+
+private:
+    union Slot
+    {
+        Slot *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr std::size_t CHUNK_ALIGNMENT = alignof(Slot) > CACHE_LINE_SIZE ? alignof(Slot) : CACHE_LINE_SIZE;
+
+    std::size_t objectsPerChunk;
+    std::vector<Slot *> chunks;
+    Slot *freeList = nullptr;
+    SlabPoolStats stats;
+
+    void grow()
+    {
+        const std::size_t bytes = objectsPerChunk * sizeof(Slot);
+        auto *chunk = static_cast<Slot *>(::operator new(bytes, std::align_val_t{CHUNK_ALIGNMENT}));
+        chunks.push_back(chunk);
+
+        // Chain the new slots in address order, so consecutive acquires hand out neighbouring memory
+        for (std::size_t i = 0; i + 1 < objectsPerChunk; ++i)
+        {
+            chunk[i].next = &chunk[i + 1];
+        }
+        chunk[objectsPerChunk - 1].next = freeList;
+        freeList = chunk;
+
+        ++stats.chunkCount;
+        stats.capacity += objectsPerChunk;
+        stats.footprintBytes += bytes;
+    }
+};
+
+#endif // SLAB_POOL_HPP
@@ -0,0 +1,149 @@
+#ifndef SPLIT_SLAB_POOL_HPP
+#define SPLIT_SLAB_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "SlabPool.hpp"
+
+// Slab pool keeping a hot and a cold record per object in two separate arrays of the same chunk.
+// Chunks are ChunkBytes large and aligned to ChunkBytes, so the slot of a hot object, and with it its cold
+// record, follows from the object's address alone: the hot object carries no pointer to its cold part and
+// walking hot objects never pulls cold bytes into the cache.
+// Like SlabPool, free hot slots are chained through an intrusive free list and the pool is not thread-safe.
+template <typename Hot, typename Cold, std::size_t ChunkBytes>
+class SplitSlabPool
+{
+    union Slot
+    {
+        Slot *next;
+        alignas(Hot) unsigned char storage[sizeof(Hot)];
+    };
+
+public:
+    static_assert((ChunkBytes & (ChunkBytes - 1)) == 0, "Chunk size must be a power of two");
+    static_assert(std::is_trivially_destructible_v<Cold>, "Cold records are dropped without destruction");
+
+    static constexpr std::size_t OBJECTS_PER_CHUNK = (ChunkBytes - alignof(Cold)) / (sizeof(Slot) + sizeof(Cold));
+    static_assert(OBJECTS_PER_CHUNK > 0, "Chunk is too small for a single object");
+
+    explicit SplitSlabPool(const std::size_t initialChunks = 1)
+    {
+        for (std::size_t i = 0; i < initialChunks; ++i)
+        {
+            grow();
+        }
+    }
+
+    // Objects still in use when the pool is destroyed are not destructed, only their memory is freed
+    ~SplitSlabPool()
+    {
+        for (void *chunk : chunks)
+        {
+            ::operator delete(chunk, std::align_val_t{ChunkBytes});
+        }
+    }
+
+    SplitSlabPool(const SplitSlabPool &) = delete;
+    auto operator=(const SplitSlabPool &) -> SplitSlabPool & = delete;
+
+    // The cold record is value-initialised before the hot object is constructed, so Hot's constructor can fill it
+    template <typename... Args>
+    auto acquire(Args &&...args) -> Hot *
+    {
+        if (freeList == nullptr)
+        {
+            grow();
+        }
+        Slot *slot = freeList;
+        Slot *next = slot->next;
+
+        new (&coldOf(slot)) Cold{};
+        Hot *object;
+        try
+        {
+            object = new (slot->storage) Hot(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            slot->next = next;
+            throw;
+        }
+        freeList = next;
+
+        ++stats.acquireCount;
+        if (++stats.inUse > stats.peakInUse)
+        {
+            stats.peakInUse = stats.inUse;
+        }
+        return object;
+    }
+
+    void release(Hot *object)
+    {
+        object->~Hot();
+        auto *slot = reinterpret_cast<Slot *>(object);
+        slot->next = freeList;
+        freeList = slot;
+
+        ++stats.releaseCount;
+        --stats.inUse;
+    }
+
+    // Cold record of an object handed out by any pool of this type
+    static auto cold(Hot *object) -> Cold &
+    {
+        return coldOf(object);
+    }
+
+    static auto cold(const Hot *object) -> const Cold &
+    {
+        return coldOf(const_cast<Hot *>(object));
+    }
+
+    [[nodiscard]] auto getStats() const -> const SlabPoolStats &
+    {
+        return stats;
+    }
+
+private:
+    static constexpr std::size_t COLD_OFFSET =
+        (OBJECTS_PER_CHUNK * sizeof(Slot) + alignof(Cold) - 1) / alignof(Cold) * alignof(Cold);
+    static_assert(COLD_OFFSET + OBJECTS_PER_CHUNK * sizeof(Cold) <= ChunkBytes);
+
+    std::vector<void *> chunks;
+    Slot *freeList = nullptr;
+    SlabPoolStats stats;
+
+    template <typename T>
+    static auto coldOf(T *object) -> Cold &
+    {
+        const auto address = reinterpret_cast<std::uintptr_t>(object);
+        const std::uintptr_t chunk = address & ~static_cast<std::uintptr_t>(ChunkBytes - 1);
+        const std::size_t index = (address - chunk) / sizeof(Slot);
+        return *std::launder(reinterpret_cast<Cold *>(chunk + COLD_OFFSET + index * sizeof(Cold)));
+    }
+
+    void grow()
+    {
+        void *memory = ::operator new(ChunkBytes, std::align_val_t{ChunkBytes});
+        chunks.push_back(memory);
+
+        auto *slots = static_cast<Slot *>(memory);
+        for (std::size_t i = 0; i + 1 < OBJECTS_PER_CHUNK; ++i)
+        {
+            slots[i].next = &slots[i + 1];
+        }
+        slots[OBJECTS_PER_CHUNK - 1].next = freeList;
+        freeList = slots;
+
+        ++stats.chunkCount;
+        stats.capacity += OBJECTS_PER_CHUNK;
+        stats.footprintBytes += ChunkBytes;
+    }
+};
+
+#endif // SPLIT_SLAB_POOL_HPP
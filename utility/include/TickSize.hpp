@@ -0,0 +1,12 @@
+// TickSize.hpp
+#ifndef MATCHING_ENGINE_TICK_SIZE_HPP
+#define MATCHING_ENGINE_TICK_SIZE_HPP
+
+#include <cstdint>
+
+// Prices inside the system are an integer number of ticks of the instrument's tick size.
+// Conversion from and to decimal prices only happens at the edges (protocol parsing and display),
+// using the tick size kept by the InstrumentRegistry.
+using Price = std::int64_t;
+
+#endif // MATCHING_ENGINE_TICK_SIZE_HPP
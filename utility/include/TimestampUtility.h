@@ -2,8 +2,23 @@
 #define TIMESTAMP_UTILITY_H
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 
+// Reading of the process-wide monotonic clock, in clock ticks. 0 is never a reading and marks "not stamped".
+// The clock is the invariant TSC when the CPU has one (rdtsc, a few nanoseconds, no syscall and never stepped
+// by NTP), otherwise CLOCK_MONOTONIC nanoseconds, which the vDSO also serves without a syscall. Ticks are
+// only turned into nanoseconds or wall time when they are reported or formatted.
+using Timestamp = std::uint64_t;
+
+auto monotonicNow() -> Timestamp;
+// True when Timestamps are TSC ticks, false on the CLOCK_MONOTONIC fallback
+auto isTscClock() -> bool;
+// Length of a span of ticks, using the rate calibrated at first use of the clock
+auto ticksToNanoseconds(Timestamp ticks) -> double;
+// Wall time of a reading, relative to a system_clock anchor taken when the clock was calibrated
+auto toWallClock(Timestamp timestamp) -> std::chrono::system_clock::time_point;
+
 auto timestampToString(const std::chrono::system_clock::time_point &timestamp) -> std::string;
 auto currentTimestamp() -> std::chrono::system_clock::time_point;
 auto durationInNanoseconds(const std::chrono::system_clock::time_point &start,
@@ -1,9 +1,12 @@
 #ifndef TRADE_H
 #define TRADE_H
 
-#include <string>
+#include <chrono>
+#include <cstdint>
+#include "InstrumentRegistry.hpp"
+#include "TickSize.hpp"
 
-enum class TradeStatus
+enum class TradeStatus : std::uint8_t
 {
     SUCCESS,
     FAILED,
@@ -11,37 +14,59 @@ enum class TradeStatus
     UNDEFINED
 };
 
-class Trade
+// One fill, as a trivially copyable record of exactly one cache line.
+// It holds IDs and integers only: building one neither allocates nor reads the clock (the engine stamps all
+// fills of an incoming order with the same timestamp), and it can be copied byte for byte into rings, logs
+// and journals. Text formatting lives with the consumers, see TradeFormat.h.
+class alignas(64) Trade
 {
 public:
     Trade(unsigned int trade_id, unsigned int buy_order_id, unsigned int sell_order_id,
-         std::string  asset, double price, int quantity);
-
-    [[nodiscard]] auto getAsset() const -> const std::string &;
-    [[nodiscard]] auto getTradeId() const -> unsigned int;
-    [[nodiscard]] auto getBuyOrderId() const -> unsigned int;
-    [[nodiscard]] auto getSellOrderId() const -> unsigned int;
-    [[nodiscard]] auto getPrice() const -> double;
-    [[nodiscard]] auto getTradeValue() const -> double;
-    [[nodiscard]] auto getQuantity() const -> int;
-    [[nodiscard]] auto getBuyOrderStatus() const -> TradeStatus;
-    [[nodiscard]] auto getSellOrderStatus() const -> TradeStatus;
-    [[nodiscard]] auto getTimestamp() const -> std::chrono::system_clock::time_point;
-
-    void setBuyOrderStatus(TradeStatus status);
-    void setSellOrderStatus(TradeStatus status);
-    [[nodiscard]] auto toString(const std::string& format = "default") const -> std::string;
+         InstrumentId instrument, Price price, int quantity,
+         std::chrono::system_clock::time_point timestamp = {})
+        : trade_id(trade_id), buy_order_id(buy_order_id), sell_order_id(sell_order_id), instrument(instrument),
+          buyOrderStatus(TradeStatus::UNDEFINED), sellOrderStatus(TradeStatus::UNDEFINED), quantity(quantity),
+          price(price),
+          timestampNs(std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count())
+    {
+    }
+
+    [[nodiscard]] auto getInstrument() const -> InstrumentId { return instrument; }
+    [[nodiscard]] auto getTradeId() const -> unsigned int { return trade_id; }
+    [[nodiscard]] auto getBuyOrderId() const -> unsigned int { return buy_order_id; }
+    [[nodiscard]] auto getSellOrderId() const -> unsigned int { return sell_order_id; }
+    [[nodiscard]] auto getPrice() const -> Price { return price; }
+    [[nodiscard]] auto getQuantity() const -> int { return quantity; }
+    [[nodiscard]] auto getBuyOrderStatus() const -> TradeStatus { return buyOrderStatus; }
+    [[nodiscard]] auto getSellOrderStatus() const -> TradeStatus { return sellOrderStatus; }
+    // Quantity each side still has open right after this fill
+    [[nodiscard]] auto getBuyLeavesQuantity() const -> int { return buyLeavesQuantity; }
+    [[nodiscard]] auto getSellLeavesQuantity() const -> int { return sellLeavesQuantity; }
+    [[nodiscard]] auto getTimestamp() const -> std::chrono::system_clock::time_point
+    {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(timestampNs)));
+    }
+
+    void setBuyOrderStatus(const TradeStatus status) { buyOrderStatus = status; }
+    void setSellOrderStatus(const TradeStatus status) { sellOrderStatus = status; }
+    void setBuyLeavesQuantity(const int leaves) { buyLeavesQuantity = leaves; }
+    void setSellLeavesQuantity(const int leaves) { sellLeavesQuantity = leaves; }
 
 private:
-    unsigned int trade_id;
-    unsigned int buy_order_id;
-    unsigned int sell_order_id;
-    std::string asset;
-    double price;
-    int quantity;
-    std::chrono::system_clock::time_point timestamp;
+    std::uint32_t trade_id;
+    std::uint32_t buy_order_id;
+    std::uint32_t sell_order_id;
+    InstrumentId instrument;
     TradeStatus buyOrderStatus;
     TradeStatus sellOrderStatus;
+    std::int32_t quantity;
+    std::int32_t buyLeavesQuantity = 0;
+    std::int32_t sellLeavesQuantity = 0;
+    Price price;
+    std::int64_t timestampNs;  // Since the system_clock epoch
 };
 
-#endif
\ No newline at end of file
+static_assert(sizeof(Trade) == 64, "Trade must fill exactly one cache line");
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef TRADE_FORMAT_H
+#define TRADE_FORMAT_H
+
+#include <string>
+#include "Trade.h"
+
+// Price times quantity in display units of the instrument
+auto getTradeValue(const Trade &trade) -> double;
+
+// Text form of a trade for logs and reports: "default" (aligned fields), "json" or "csv"
+auto formatTrade(const Trade &trade, const std::string &format = "default") -> std::string;
+
+#endif // TRADE_FORMAT_H
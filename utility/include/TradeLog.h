@@ -0,0 +1,123 @@
+#ifndef TRADE_LOG_H
+#define TRADE_LOG_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "LogFileHeader.h"
+#include "MappedFile.h"
+#include "Trade.h"
+#include "utility_config.hpp"
+
+// Append-only binary log of every trade, written through a shared memory mapping.
+// The file is a 64-byte header followed by Trade records copied byte for byte; the header keeps the record
+// count, so a log reopened after a restart continues where it stopped (a file of another layout is moved aside
+// and a new log started). Appending is a memcpy into the mapping: once the log is half full a background thread
+// doubles the file in place, so the appending thread only grows it itself if it catches up with that thread.
+// A file that fills its reserved address space is rolled over by the appending thread: it is moved aside to
+// <path>.old.<n> like a file of another layout and the log goes on in a new file at path, which is then all
+// that size(), at() and the iterators cover.
+// Not thread-safe otherwise: the owning matching thread appends, and readers iterate from that thread or once
+// it has stopped.
+class TradeLog
+{
+    static_assert(std::is_trivially_copyable_v<Trade>, "Trade records are stored as raw bytes");
+
+public:
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Trade;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Trade *;
+        using reference = const Trade &;
+
+        const_iterator() = default;
+        explicit const_iterator(const Trade *record) : record(record) {}
+
+        auto operator*() const -> reference { return *record; }
+        auto operator->() const -> pointer { return record; }
+        auto operator[](const difference_type n) const -> reference { return record[n]; }
+        auto operator++() -> const_iterator & { ++record; return *this; }
+        auto operator++(int) -> const_iterator { const_iterator old = *this; ++record; return old; }
+        auto operator--() -> const_iterator & { --record; return *this; }
+        auto operator--(int) -> const_iterator { const_iterator old = *this; --record; return old; }
+        auto operator+=(const difference_type n) -> const_iterator & { record += n; return *this; }
+        auto operator-=(const difference_type n) -> const_iterator & { record -= n; return *this; }
+        auto operator+(const difference_type n) const -> const_iterator { return const_iterator(record + n); }
+        auto operator-(const difference_type n) const -> const_iterator { return const_iterator(record - n); }
+        auto operator-(const const_iterator &other) const -> difference_type { return record - other.record; }
+        auto operator==(const const_iterator &other) const -> bool { return record == other.record; }
+        auto operator!=(const const_iterator &other) const -> bool { return record != other.record; }
+        auto operator<(const const_iterator &other) const -> bool { return record < other.record; }
+
+    private:
+        const Trade *record = nullptr;
+    };
+
+    explicit TradeLog(const std::string &path,
+                      std::size_t initialCapacity = Utility_Config::TradeLog::INITIAL_CAPACITY,
+                      std::size_t reservedSize = Utility_Config::Mapping::RESERVED_BYTES);
+
+    ~TradeLog();
+
+    TradeLog(const TradeLog &) = delete;
+    auto operator=(const TradeLog &) -> TradeLog & = delete;
+
+    void append(const Trade &trade);
+
+    [[nodiscard]] auto size() const -> std::size_t;
+    [[nodiscard]] auto empty() const -> bool;
+    [[nodiscard]] auto at(std::size_t index) const -> const Trade &;
+
+    // Iterators point into the mapping, which never moves and stays mapped after a rollover
+    [[nodiscard]] auto begin() const -> const_iterator;
+    [[nodiscard]] auto end() const -> const_iterator;
+
+    // First trade with an ID >= tradeId, trade IDs only ever increase along the log
+    [[nodiscard]] auto lowerBound(unsigned int tradeId) const -> const_iterator;
+
+    void sync() const;
+    [[nodiscard]] auto getPath() const -> const std::string &;
+
+private:
+    using Header = LogFileHeader;
+
+    std::string path;
+    std::size_t initialCapacity;
+    std::size_t reservedSize;
+    std::unique_ptr<MappedFile> file;
+    // Files rolled over from, kept mapped so iterators into them and a grow in flight stay valid
+    std::vector<std::unique_ptr<MappedFile>> retired;
+    std::size_t requestedCapacity = 0;   // Appending thread only
+
+    std::mutex growMutex;
+    std::condition_variable growSignal;
+    std::size_t growTarget = 0;          // Guarded by growMutex, bytes the grower should extend growFile to
+    MappedFile *growFile = nullptr;      // Guarded by growMutex
+    bool stopping = false;               // Guarded by growMutex
+    std::thread grower;
+
+    [[nodiscard]] auto header() const -> Header *;
+    [[nodiscard]] auto records() const -> Trade *;
+    [[nodiscard]] auto capacity() const -> std::size_t;
+    // File size holding twice the current capacity, within the reservation
+    [[nodiscard]] auto doubledSize() const -> std::size_t;
+
+    // Writes the header of a new log, leaves a log of this layout as it is
+    void startHeader();
+    // Called with the file full: grows it, or rolls over once it cannot grow any further
+    void makeRoom();
+    void rollOver();
+    void growLoop();
+};
+
+#endif // TRADE_LOG_H
@@ -0,0 +1,321 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include "InputJournal.h"
+#include "Logger.hpp"
+
+namespace
+{
+    constexpr char MAGIC[8] = {'M', 'E', 'J', 'O', 'U', 'R', 'N', 'L'};
+    constexpr std::uint32_t VERSION = 1;
+}
+
+auto parseJournalSyncPolicy(const std::string &name) -> JournalSyncPolicy
+{
+    if (name == "none")
+    {
+        return JournalSyncPolicy::NONE;
+    }
+    if (name == "periodic")
+    {
+        return JournalSyncPolicy::PERIODIC;
+    }
+    if (name == "group_commit")
+    {
+        return JournalSyncPolicy::GROUP_COMMIT;
+    }
+    throw std::invalid_argument("Unknown journal sync policy: " + name + " (none, periodic, group_commit)");
+}
+
+InputJournal::InputJournal(const std::string &path, const JournalSyncPolicy policy, const std::size_t initialCapacity,
+                           const std::size_t reservedSize)
+    : path(path), initialCapacity(std::max<std::size_t>(initialCapacity, 1)), reservedSize(reservedSize),
+      file(std::make_unique<MappedFile>(startNewLogFile(path, "holds the input journal of an earlier run"),
+                                        sizeof(Header) + this->initialCapacity * sizeof(JournalRecord), reservedSize)),
+      policy(policy)
+{
+    startHeader();
+    appended = 0;
+    committed = 0;
+    durable = 0;
+
+    // Runs under every policy, it also grows the file
+    running = true;
+    syncer = std::thread(&InputJournal::syncLoop, this);
+}
+
+InputJournal::~InputJournal()
+{
+    running = false;
+    syncer.join();
+}
+
+void InputJournal::append(const Message &message, const std::uint32_t orderId)
+{
+    if (appended - fileStart == capacity())
+    {
+        // The syncer is behind, or failed to grow the file, or the file reached its reserved size
+        makeRoom();
+    }
+
+    JournalRecord &record = records()[appended - fileStart];
+    record = JournalRecord{};
+    record.sequence = appended + 1;
+    record.timestamp = message.timestamp;
+    record.clientId = message.client_id;
+    record.type = message.type;
+    switch (message.type)
+    {
+    case MessageType::ADD_ORDER:
+    {
+        const AddOrderDetails &details = *message.addOrderDetails;
+        record.orderId = orderId;
+        record.instrument = details.instrument;
+        record.price = details.price;
+        record.quantity = details.quantity;
+        record.isBuy = details.isBuy;
+        record.orderType = details.type;
+        break;
+    }
+    case MessageType::MODIFY_ORDER:
+    {
+        const ModifyOrderDetails &details = *message.modifyDetails;
+        record.orderId = details.orderId;
+        record.instrument = details.instrument;
+        record.price = details.newPrice;
+        record.quantity = details.newQuantity;
+        break;
+    }
+    case MessageType::CANCEL_ORDER:
+    {
+        const CancelOrderDetails &details = *message.cancelDetails;
+        record.orderId = details.orderId;
+        record.instrument = details.instrument;
+        break;
+    }
+    default:
+        throw std::invalid_argument("Only order messages can be journaled.");
+    }
+    ++appended;
+}
+
+auto InputJournal::commit() -> std::uint64_t
+{
+    // The record bytes are in the mapping before the count that makes them part of the journal
+    header()->recordCount = appended - fileStart;
+    committed.store(appended, std::memory_order_release);
+    return appended;
+}
+
+auto InputJournal::size() const -> std::size_t
+{
+    return static_cast<std::size_t>(committed.load(std::memory_order_acquire));
+}
+
+auto InputJournal::durableCount() const -> std::uint64_t
+{
+    return durable.load(std::memory_order_acquire);
+}
+
+auto InputJournal::at(const std::size_t index) const -> const JournalRecord &
+{
+    if (index >= size())
+    {
+        throw std::out_of_range("Input journal index out of range.");
+    }
+    if (index < fileStart)
+    {
+        throw std::out_of_range("Input journal record was rolled over to an earlier file.");
+    }
+    return records()[index - fileStart];
+}
+
+auto InputJournal::getPolicy() const -> JournalSyncPolicy
+{
+    return policy;
+}
+
+auto InputJournal::getPath() const -> const std::string &
+{
+    return path;
+}
+
+void InputJournal::setDurableCallback(std::function<void(std::uint64_t)> callback)
+{
+    std::lock_guard<std::mutex> lock(syncMutex);
+    durableCallback = std::move(callback);
+}
+
+void InputJournal::sync()
+{
+    syncCommitted();
+}
+
+auto InputJournal::toMessage(const JournalRecord &record) -> Message
+{
+    Message message;
+    switch (record.type)
+    {
+    case MessageType::ADD_ORDER:
+        message = Message::createAddOrderMessage(record.instrument, record.price, record.quantity, record.isBuy, record.orderType);
+        break;
+    case MessageType::MODIFY_ORDER:
+        message = Message::createModifyOrderMessage(record.orderId, record.instrument, record.price, record.quantity);
+        break;
+    case MessageType::CANCEL_ORDER:
+        message = Message::createCancelOrderMessage(record.orderId, record.instrument);
+        break;
+    default:
+        throw std::invalid_argument("Corrupt input journal record.");
+    }
+    message.client_id = record.clientId;
+    message.timestamp = record.timestamp;
+    return message;
+}
+
+auto InputJournal::readRecords(const std::string &path) -> std::vector<JournalRecord>
+{
+    std::ifstream in(path, std::ios::binary);
+    Header head{};
+    if (!in.read(reinterpret_cast<char *>(&head), sizeof(head)) || std::memcmp(head.magic, MAGIC, sizeof(MAGIC)) != 0
+        || head.version != VERSION || head.recordSize != sizeof(JournalRecord))
+    {
+        throw std::runtime_error(path + " is not an input journal of this layout.");
+    }
+    std::vector<JournalRecord> result(head.recordCount);
+    in.read(reinterpret_cast<char *>(result.data()), static_cast<std::streamsize>(result.size() * sizeof(JournalRecord)));
+    // A journal cut short keeps the records that made it to disk
+    result.resize(static_cast<std::size_t>(in.gcount()) / sizeof(JournalRecord));
+    return result;
+}
+
+auto InputJournal::header() const -> Header *
+{
+    return reinterpret_cast<Header *>(file->data());
+}
+
+auto InputJournal::records() const -> JournalRecord *
+{
+    return reinterpret_cast<JournalRecord *>(file->data() + sizeof(Header));
+}
+
+auto InputJournal::capacity() const -> std::size_t
+{
+    return (file->size() - sizeof(Header)) / sizeof(JournalRecord);
+}
+
+auto InputJournal::doubledSize() const -> std::size_t
+{
+    return std::min(sizeof(Header) + 2 * capacity() * sizeof(JournalRecord), file->getReservedSize());
+}
+
+void InputJournal::startHeader()
+{
+    Header *head = header();
+    std::memcpy(head->magic, MAGIC, sizeof(MAGIC));
+    head->version = VERSION;
+    head->recordSize = sizeof(JournalRecord);
+    head->recordCount = 0;
+}
+
+void InputJournal::makeRoom()
+{
+    if (file->size() < file->getReservedSize())
+    {
+        file->grow(doubledSize());
+    }
+    if (capacity() == appended - fileStart)
+    {
+        rollOver();
+    }
+}
+
+void InputJournal::rollOver()
+{
+    // Once per reserved size worth of records, the only time the matching thread waits for the syncer
+    std::lock_guard<std::mutex> lock(syncMutex);
+    // The records of the batch in flight stay in the file they were written to
+    header()->recordCount = appended - fileStart;
+    if (policy != JournalSyncPolicy::NONE)
+    {
+        const std::uint64_t from = std::max(durable.load(std::memory_order_relaxed), fileStart);
+        file->sync(sizeof(Header) + (from - fileStart) * sizeof(JournalRecord), (appended - from) * sizeof(JournalRecord));
+        file->sync(0, sizeof(Header));
+    }
+    file = std::make_unique<MappedFile>(startNewLogFile(path, "filled the address space reserved for an input journal"),
+                                        sizeof(Header) + initialCapacity * sizeof(JournalRecord), reservedSize);
+    startHeader();
+    fileStart = appended;
+}
+
+void InputJournal::syncLoop()
+{
+    const auto interval = policy == JournalSyncPolicy::GROUP_COMMIT
+        ? std::chrono::microseconds(Utility_Config::Journal::GROUP_COMMIT_POLL_US)
+        : std::chrono::microseconds(std::chrono::milliseconds(Utility_Config::Journal::SYNC_INTERVAL_MS));
+    bool last = false;
+    while (!last)
+    {
+        // One more round after stopping picks up the final commits
+        last = !running;
+        if (!last)
+        {
+            std::this_thread::sleep_for(interval);
+        }
+        try
+        {
+            growAhead();
+            if (policy != JournalSyncPolicy::NONE)
+            {
+                syncCommitted();
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // The records stay committed in the page cache, the next round tries again
+            Logger::getLogger()->error(e.what());
+        }
+    }
+}
+
+auto InputJournal::syncCommitted() -> std::uint64_t
+{
+    std::lock_guard<std::mutex> lock(syncMutex);
+    return syncLocked();
+}
+
+auto InputJournal::syncLocked() -> std::uint64_t
+{
+    const std::uint64_t target = committed.load(std::memory_order_acquire);
+    const std::uint64_t synced = durable.load(std::memory_order_relaxed);
+    if (target == synced)
+    {
+        return target;
+    }
+    // Records of earlier files were synced when the file was rolled over
+    const std::uint64_t from = std::max(synced, fileStart);
+    if (target > from)
+    {
+        file->sync(sizeof(Header) + (from - fileStart) * sizeof(JournalRecord), (target - from) * sizeof(JournalRecord));
+        file->sync(0, sizeof(Header));
+    }
+    durable.store(target, std::memory_order_release);
+    if (durableCallback)
+    {
+        durableCallback(target);
+    }
+    return target;
+}
+
+void InputJournal::growAhead()
+{
+    std::lock_guard<std::mutex> lock(syncMutex);
+    // The batch in flight when the file rolled over may not be committed yet
+    const std::uint64_t inFile = std::max(committed.load(std::memory_order_acquire), fileStart) - fileStart;
+    if (file->size() < file->getReservedSize() && 2 * inFile >= capacity())
+    {
+        file->grow(doubledSize());
+    }
+}
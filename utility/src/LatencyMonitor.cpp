@@ -0,0 +1,222 @@
+#include "LatencyMonitor.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include "TimestampUtility.h"
+
+auto latencyStageName(const LatencyStage stage) -> const char *
+{
+    switch (stage)
+    {
+    case LatencyStage::QUEUE_WAIT:
+        return "queue_wait";
+    case LatencyStage::MATCH:
+        return "match";
+    case LatencyStage::ACK:
+        return "ack";
+    case LatencyStage::END_TO_END:
+        return "end_to_end";
+    default:
+        return "unknown";
+    }
+}
+
+void LatencyHistogram::record(const std::uint64_t value)
+{
+    // Single writer: plain load/store instead of a locked add
+    std::atomic<std::uint64_t> &bucket = buckets[bucketIndex(value)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    total.store(total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (value > maxValue.load(std::memory_order_relaxed))
+    {
+        maxValue.store(value, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other)
+{
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        if (const std::uint64_t n = other.buckets[i].load(std::memory_order_relaxed); n != 0)
+        {
+            buckets[i].fetch_add(n, std::memory_order_relaxed);
+        }
+    }
+    total.fetch_add(other.total.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    const std::uint64_t otherMax = other.maxValue.load(std::memory_order_relaxed);
+    if (otherMax > maxValue.load(std::memory_order_relaxed))
+    {
+        maxValue.store(otherMax, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (std::atomic<std::uint64_t> &bucket : buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    maxValue.store(0, std::memory_order_relaxed);
+}
+
+auto LatencyHistogram::count() const -> std::uint64_t
+{
+    return total.load(std::memory_order_relaxed);
+}
+
+auto LatencyHistogram::max() const -> std::uint64_t
+{
+    return maxValue.load(std::memory_order_relaxed);
+}
+
+auto LatencyHistogram::valueAtPercentile(const double percentile) const -> std::uint64_t
+{
+    // Buckets are read once, concurrent records make the total a moving target
+    std::array<std::uint64_t, BUCKET_COUNT> counts;
+    std::uint64_t sum = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        counts[i] = buckets[i].load(std::memory_order_relaxed);
+        sum += counts[i];
+    }
+    if (sum == 0)
+    {
+        return 0;
+    }
+
+    const double clamped = std::clamp(percentile, 0.0, 100.0);
+    const auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(sum))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i)
+    {
+        seen += counts[i];
+        if (seen >= target)
+        {
+            return std::min(bucketUpperBound(i), max());
+        }
+    }
+    return max();
+}
+
+auto LatencyHistogram::bucketIndex(const std::uint64_t value) -> std::size_t
+{
+    if (value < SUB_BUCKET_COUNT)
+    {
+        return static_cast<std::size_t>(value);
+    }
+    const auto exponent = static_cast<unsigned int>(63 - __builtin_clzll(value));
+    const unsigned int shift = exponent - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKET_COUNT + static_cast<std::size_t>((value >> shift) & (SUB_BUCKET_COUNT - 1));
+}
+
+auto LatencyHistogram::bucketUpperBound(const std::size_t index) -> std::uint64_t
+{
+    if (index < SUB_BUCKET_COUNT)
+    {
+        return index;
+    }
+    const std::size_t shift = index / SUB_BUCKET_COUNT - 1;
+    const std::uint64_t lower = static_cast<std::uint64_t>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+thread_local LatencyMonitor::StageHistograms *LatencyMonitor::local = nullptr;
+
+LatencyMonitor::LatencyMonitor() = default;
+
+auto LatencyMonitor::getInstance() -> LatencyMonitor &
+{
+    static LatencyMonitor instance;
+    return instance;
+}
+
+auto LatencyMonitor::now() -> std::uint64_t
+{
+    return monotonicNow();
+}
+
+void LatencyMonitor::record(const LatencyStage stage, const std::uint64_t start, const std::uint64_t end)
+{
+    if (start == 0 || end < start)
+    {
+        return;
+    }
+    localHistograms()[static_cast<std::size_t>(stage)].record(end - start);
+}
+
+auto LatencyMonitor::merged(const LatencyStage stage) const -> std::unique_ptr<LatencyHistogram>
+{
+    auto result = std::make_unique<LatencyHistogram>();
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    for (const auto &histograms : threadHistograms)
+    {
+        result->merge((*histograms)[static_cast<std::size_t>(stage)]);
+    }
+    return result;
+}
+
+auto LatencyMonitor::summary(const LatencyStage stage) const -> LatencySummary
+{
+    const std::unique_ptr<LatencyHistogram> histogram = merged(stage);
+    LatencySummary result;
+    result.count = histogram->count();
+    result.p50 = ticksToNanoseconds(histogram->valueAtPercentile(50.0));
+    result.p99 = ticksToNanoseconds(histogram->valueAtPercentile(99.0));
+    result.p999 = ticksToNanoseconds(histogram->valueAtPercentile(99.9));
+    result.max = ticksToNanoseconds(histogram->max());
+    return result;
+}
+
+auto LatencyMonitor::report() const -> std::string
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < static_cast<std::size_t>(LatencyStage::COUNT); ++i)
+    {
+        const auto stage = static_cast<LatencyStage>(i);
+        const LatencySummary stats = summary(stage);
+        if (i != 0)
+        {
+            oss << '\n';
+        }
+        oss << std::left << std::setw(12) << latencyStageName(stage) << std::right
+            << " count=" << stats.count
+            << " p50=" << stats.p50 / 1000.0 << "us"
+            << " p99=" << stats.p99 / 1000.0 << "us"
+            << " p99.9=" << stats.p999 / 1000.0 << "us"
+            << " max=" << stats.max / 1000.0 << "us";
+    }
+    return oss.str();
+}
+
+auto LatencyMonitor::ticksToNanoseconds(const std::uint64_t ticks) const -> double
+{
+    return ::ticksToNanoseconds(ticks);
+}
+
+void LatencyMonitor::reset()
+{
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    for (const auto &histograms : threadHistograms)
+    {
+        for (LatencyHistogram &histogram : *histograms)
+        {
+            histogram.reset();
+        }
+    }
+}
+
+auto LatencyMonitor::localHistograms() -> StageHistograms &
+{
+    // Only the first record of a thread takes the lock, the histograms outlive the thread
+    if (local == nullptr)
+    {
+        auto histograms = std::make_unique<StageHistograms>();
+        local = histograms.get();
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        threadHistograms.push_back(std::move(histograms));
+    }
+    return *local;
+}
@@ -0,0 +1,84 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "LogFileHeader.h"
+#include "Logger.hpp"
+
+namespace
+{
+    // Why the file at path cannot be continued, empty if it can
+    auto incompatibility(const std::string &path, const std::uintmax_t fileSize, const char (&magic)[8],
+                         const std::uint32_t version, const std::uint32_t recordSize) -> std::string
+    {
+        LogFileHeader header{};
+        std::ifstream in(path, std::ios::binary);
+        if (!in.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        {
+            return "is too short to be a log";
+        }
+        if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0)
+        {
+            return "is not a log of this kind";
+        }
+        if (header.version != version || header.recordSize != recordSize)
+        {
+            return "was written with layout version " + std::to_string(header.version) + ", this build writes "
+                + std::to_string(version);
+        }
+        if (header.recordCount > (fileSize - sizeof(header)) / recordSize)
+        {
+            return "is truncated";
+        }
+        return {};
+    }
+
+    void moveAside(const std::string &path, const std::string &reason, const bool warn)
+    {
+        std::string aside = path + ".old";
+        for (int n = 1; std::filesystem::exists(aside); ++n)
+        {
+            aside = path + ".old." + std::to_string(n);
+        }
+        std::error_code error;
+        std::filesystem::rename(path, aside, error);
+        if (error)
+        {
+            throw std::runtime_error(path + " " + reason + " and cannot be moved aside: " + error.message());
+        }
+        const auto logger = Logger::getLogger();
+        logger->log(warn ? spdlog::level::warn : spdlog::level::info, "{} {}, moved it to {} and started a new log.",
+                    path, reason, aside);
+    }
+}
+
+auto prepareLogFile(const std::string &path, const char (&magic)[8], const std::uint32_t version,
+                    const std::uint32_t recordSize) -> const std::string &
+{
+    std::error_code error;
+    const std::uintmax_t fileSize = std::filesystem::file_size(path, error);
+    if (error || fileSize == 0)
+    {
+        // Nothing there yet, or an empty file the log can be started in
+        return path;
+    }
+
+    const std::string reason = incompatibility(path, fileSize, magic, version, recordSize);
+    if (reason.empty())
+    {
+        return path;
+    }
+
+    moveAside(path, reason, true);
+    return path;
+}
+
+auto startNewLogFile(const std::string &path, const std::string &reason) -> const std::string &
+{
+    std::error_code error;
+    if (const std::uintmax_t fileSize = std::filesystem::file_size(path, error); !error && fileSize != 0)
+    {
+        moveAside(path, reason, false);
+    }
+    return path;
+}
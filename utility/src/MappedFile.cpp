@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "MappedFile.h"
+
+namespace
+{
+    [[noreturn]] void throwSystemError(const std::string &what, const std::string &path)
+    {
+        throw std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+    }
+
+    auto pageSize() -> std::size_t
+    {
+        static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    auto pageFloor(const std::size_t offset) -> std::size_t
+    {
+        return offset - offset % pageSize();
+    }
+
+    auto pageCeil(const std::size_t offset) -> std::size_t
+    {
+        return pageFloor(offset + pageSize() - 1);
+    }
+}
+
+MappedFile::MappedFile(std::string path, const std::size_t minimumSize, const std::size_t reservedSize)
+    : path(std::move(path))
+{
+    fd = ::open(this->path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0)
+    {
+        throwSystemError("Cannot open", this->path);
+    }
+
+    struct stat status{};
+    if (::fstat(fd, &status) != 0)
+    {
+        ::close(fd);
+        throwSystemError("Cannot stat", this->path);
+    }
+    const std::size_t size = std::max(static_cast<std::size_t>(status.st_size), minimumSize);
+
+    // Address space only: no memory or swap is committed until the file is mapped over it
+    this->reservedSize = pageCeil(std::max(reservedSize, size));
+    void *address = ::mmap(nullptr, this->reservedSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (address == MAP_FAILED)
+    {
+        ::close(fd);
+        throwSystemError("Cannot reserve address space for", this->path);
+    }
+    mapping = static_cast<char *>(address);
+
+    try
+    {
+        resize(size);
+    }
+    catch (...)
+    {
+        ::munmap(mapping, this->reservedSize);
+        ::close(fd);
+        throw;
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    ::munmap(mapping, reservedSize);
+    ::close(fd);
+}
+
+void MappedFile::resize(const std::size_t newSize)
+{
+    std::lock_guard<std::mutex> lock(resizeMutex);
+    resizeLocked(newSize);
+}
+
+void MappedFile::grow(const std::size_t minimumSize)
+{
+    std::lock_guard<std::mutex> lock(resizeMutex);
+    if (mappedSize.load(std::memory_order_relaxed) < minimumSize)
+    {
+        resizeLocked(minimumSize);
+    }
+}
+
+void MappedFile::resizeLocked(const std::size_t newSize)
+{
+    if (newSize == 0)
+    {
+        throw std::invalid_argument("MappedFile size must be positive.");
+    }
+    if (newSize > reservedSize)
+    {
+        throw std::length_error("Cannot grow " + path + " past its reserved address space.");
+    }
+
+    const std::size_t oldSize = mappedSize.load(std::memory_order_relaxed);
+    if (newSize == oldSize)
+    {
+        return;
+    }
+    if (newSize < oldSize)
+    {
+        // Hand the tail back to the reservation before the file shrinks under it
+        const std::size_t tail = pageCeil(newSize);
+        if (tail < pageCeil(oldSize)
+            && ::mmap(mapping + tail, pageCeil(oldSize) - tail, PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0) == MAP_FAILED)
+        {
+            throwSystemError("Cannot unmap the tail of", path);
+        }
+        mappedSize.store(newSize, std::memory_order_release);
+        if (::ftruncate(fd, static_cast<off_t>(newSize)) != 0)
+        {
+            throwSystemError("Cannot resize", path);
+        }
+        return;
+    }
+
+    struct stat status{};
+    if (::fstat(fd, &status) != 0)
+    {
+        throwSystemError("Cannot stat", path);
+    }
+    const auto fileSize = static_cast<std::size_t>(status.st_size);
+    if (fileSize < newSize && ::ftruncate(fd, static_cast<off_t>(newSize)) != 0)
+    {
+        throwSystemError("Cannot resize", path);
+    }
+    // Reserve the blocks now rather than on first write through the mapping
+    if (const int ret = ::posix_fallocate(fd, 0, static_cast<off_t>(newSize)); ret != 0 && ret != EOPNOTSUPP)
+    {
+        if (fileSize < newSize)
+        {
+            static_cast<void>(::ftruncate(fd, static_cast<off_t>(fileSize)));
+        }
+        errno = ret;
+        throwSystemError("Cannot preallocate", path);
+    }
+    // Only pages past the old end are mapped, over the reservation, so a failure never touches the mapped part.
+    // The page holding the old end was mapped whole and already shows the bytes the file gained in it.
+    const std::size_t start = pageCeil(oldSize);
+    if (newSize > start
+        && ::mmap(mapping + start, newSize - start, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd,
+                  static_cast<off_t>(start)) == MAP_FAILED)
+    {
+        const int error = errno;
+        if (fileSize < newSize)
+        {
+            static_cast<void>(::ftruncate(fd, static_cast<off_t>(fileSize)));
+        }
+        errno = error;
+        throwSystemError("Cannot map", path);
+    }
+    mappedSize.store(newSize, std::memory_order_release);
+}
+
+void MappedFile::sync(const bool async) const
+{
+    if (::msync(mapping, mappedSize.load(std::memory_order_acquire), async ? MS_ASYNC : MS_SYNC) != 0)
+    {
+        throwSystemError("Cannot sync", path);
+    }
+}
+
+void MappedFile::sync(const std::size_t offset, const std::size_t length, const bool async) const
+{
+    if (length == 0)
+    {
+        return;
+    }
+    // msync wants a page aligned start
+    const std::size_t start = pageFloor(offset);
+    const std::size_t end = std::min(offset + length, mappedSize.load(std::memory_order_acquire));
+    if (::msync(mapping + start, end - start, async ? MS_ASYNC : MS_SYNC) != 0)
+    {
+        throwSystemError("Cannot sync", path);
+    }
+}
+
+auto MappedFile::data() const -> char *
+{
+    return mapping;
+}
+
+auto MappedFile::size() const -> std::size_t
+{
+    return mappedSize.load(std::memory_order_acquire);
+}
+
+auto MappedFile::getReservedSize() const -> std::size_t
+{
+    return reservedSize;
+}
+
+auto MappedFile::getPath() const -> const std::string &
+{
+    return path;
+}
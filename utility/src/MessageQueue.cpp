@@ -1,69 +1,246 @@
 // OrderQueue.cpp
 
+#include <stdexcept>
+#include <thread>
 #include "MessageQueue.h"
+#include "OrderTracer.h"
 
-MessageQueue::MessageQueue() 
-= default;
+namespace {
+    auto roundUpToPowerOfTwo(const std::size_t value) -> std::size_t {
+        std::size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#endif
+    }
+}
+
+auto MessageQueue::parseWaitStrategy(const std::string& name) -> WaitStrategy {
+    if (name == "busy_spin") {
+        return WaitStrategy::BUSY_SPIN;
+    }
+    if (name == "spin_yield") {
+        return WaitStrategy::SPIN_YIELD;
+    }
+    if (name == "spin_park") {
+        return WaitStrategy::SPIN_PARK;
+    }
+    if (name == "blocking") {
+        return WaitStrategy::BLOCKING;
+    }
+    throw std::invalid_argument("Unknown wait strategy: " + name);
+}
+
+MessageQueue::MessageQueue(const std::size_t capacity, const ProducerMode producerMode, const WaitStrategy waitStrategy)
+    : m_capacity(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)), m_mask(m_capacity - 1),
+      m_producerMode(producerMode), m_waitStrategy(waitStrategy),
+      m_canPark(waitStrategy == WaitStrategy::SPIN_PARK || waitStrategy == WaitStrategy::BLOCKING),
+      m_slots(std::make_unique<Slot[]>(m_capacity))
+{
+    // Slot i is free for the producer at position i
+    for (std::size_t i = 0; i < m_capacity; ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
 
 MessageQueue::~MessageQueue() 
 = default;
 
 void MessageQueue::push(Message&& msg) {
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_queue.emplace(std::move(msg));
+    OrderTracer::getInstance().record(msg.traceId, TraceStage::QUEUE_PUSH);
+    while (!tryPush(std::move(msg))) {
+        // Back-pressure: wait for the consumer to free a slot
+        if (isShutdown()) {
+            throw std::runtime_error("MessageQueue is full and shut down.");
+        }
+        std::this_thread::yield();
     }
-    m_condVar.notify_one(); // Notify a readied consumer
 }
 
-auto MessageQueue::pop(Message& msg) -> bool {
-    // The incoming parameter msg is used to store the information popped out of the queue
-    std::unique_lock<std::mutex> lock(m_mutex);
-    m_condVar.wait(lock, [this]() { return !m_queue.empty() || m_shutdown; }); // Block and wait until the queue is not empty
+auto MessageQueue::tryPush(Message&& msg) -> bool {
+    std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
 
-    if (m_shutdown && m_queue.empty()) {
-        return false;
+    if (m_producerMode == ProducerMode::SINGLE) {
+        slot = &m_slots[pos & m_mask];
+        if (slot->sequence.load(std::memory_order_acquire) != pos) {
+            return false; // The consumer has not released this slot yet: full
+        }
+        m_enqueuePos.store(pos + 1, std::memory_order_relaxed);
+    } else {
+        while (true) {
+            slot = &m_slots[pos & m_mask];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                // The slot is free at this position, claim it
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // full
+            } else {
+                // Another producer claimed this position first
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    slot->message = std::move(msg);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    if (m_canPark) {
+        wakeConsumer();
     }
+    return true;
+}
 
+auto MessageQueue::pop(Message& msg) -> bool {
+    // The incoming parameter msg is used to store the information popped out of the queue
+    int spins = 0;
+    while (!tryPop(msg)) {
+        if (isShutdown()) {
+            // Messages pushed before the shutdown are still delivered
+            return tryPop(msg);
+        }
 
-    if (!m_queue.empty()) {
-        msg = std::move(m_queue.front());
-        m_queue.pop();
-        return true;
+        switch (m_waitStrategy) {
+        case WaitStrategy::BUSY_SPIN:
+            cpuRelax();
+            break;
+        case WaitStrategy::SPIN_YIELD:
+            if (spins < Utility_Config::MessageQueue::SPIN_LIMIT) {
+                ++spins;
+                cpuRelax();
+            } else {
+                std::this_thread::yield();
+            }
+            break;
+        case WaitStrategy::SPIN_PARK:
+            if (spins < Utility_Config::MessageQueue::SPIN_LIMIT) {
+                ++spins;
+                cpuRelax();
+            } else {
+                parkConsumer();
+                spins = 0;
+            }
+            break;
+        case WaitStrategy::BLOCKING:
+            parkConsumer();
+            break;
+        }
     }
-    return false;
+    return true;
 }
 
 auto MessageQueue::tryPop(Message& msg) -> bool {
     // The incoming parameter msg is used to store the information popped out of the queue
-    std::lock_guard<std::mutex> lock(m_mutex);
-    if (m_queue.empty()) {
+    const std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[pos & m_mask];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
         return false;
     }
-    msg = std::move(m_queue.front());
-    m_queue.pop();
+
+    msg = std::move(slot.message);
+    // Hand the slot back to the producer one lap later
+    slot.sequence.store(pos + m_capacity, std::memory_order_release);
+    m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
     return true;
 }
 
+auto MessageQueue::popBatch(std::vector<Message>& batch, const size_t maxCount) -> size_t {
+    batch.clear();
+    if (maxCount == 0) {
+        return 0;
+    }
+    batch.emplace_back();
+    if (!pop(batch.back())) {
+        batch.clear();
+        return 0;
+    }
+    if (maxCount > 1) {
+        takeReady(batch, maxCount - 1);
+    }
+    return batch.size();
+}
+
+auto MessageQueue::drain(std::vector<Message>& batch, const size_t maxCount) -> size_t {
+    batch.clear();
+    takeReady(batch, maxCount);
+    return batch.size();
+}
+
+auto MessageQueue::takeReady(std::vector<Message>& batch, const size_t maxCount) -> size_t {
+    // Slots are handed back one by one, the consumer position is published once for the whole run
+    const std::size_t first = m_dequeuePos.load(std::memory_order_relaxed);
+    std::size_t pos = first;
+    while (pos - first < maxCount) {
+        Slot& slot = m_slots[pos & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+            break;
+        }
+        batch.push_back(std::move(slot.message));
+        slot.sequence.store(pos + m_capacity, std::memory_order_release);
+        ++pos;
+    }
+    m_dequeuePos.store(pos, std::memory_order_relaxed);
+    return pos - first;
+}
+
 auto MessageQueue::empty() const -> bool {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_queue.empty();
+    return size() == 0;
 }
 
 auto MessageQueue::size() const -> size_t {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_queue.size();
+    const std::size_t dequeuePos = m_dequeuePos.load(std::memory_order_acquire);
+    const std::size_t enqueuePos = m_enqueuePos.load(std::memory_order_acquire);
+    // Claimed positions may not be published yet, this is a snapshot
+    return (enqueuePos > dequeuePos) ? enqueuePos - dequeuePos : 0;
+}
+
+auto MessageQueue::capacity() const -> size_t {
+    return m_capacity;
+}
+
+auto MessageQueue::getWaitStrategy() const -> WaitStrategy {
+    return m_waitStrategy;
 }
 
 void MessageQueue::shutdown() {
-    {
-        std::lock_guard<std::mutex> lock(m_mutex);
-        m_shutdown = true;
-    }
-    m_condVar.notify_all(); // 通知所有等待的线程
+    m_shutdown.store(true, std::memory_order_seq_cst);
+    std::lock_guard<std::mutex> lock(m_parkMutex);
+    m_parkCondVar.notify_all(); // 通知所有等待的线程
 }
 
 bool MessageQueue::isShutdown() const {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_shutdown;
-}
\ No newline at end of file
+    return m_shutdown.load(std::memory_order_acquire);
+}
+
+auto MessageQueue::hasMessage() const -> bool {
+    const std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    return m_slots[pos & m_mask].sequence.load(std::memory_order_acquire) == pos + 1;
+}
+
+void MessageQueue::parkConsumer() {
+    std::unique_lock<std::mutex> lock(m_parkMutex);
+    m_consumerParked.store(true, std::memory_order_relaxed);
+    // Pairs with the fence in wakeConsumer: either the producer sees the flag or we see its message
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    m_parkCondVar.wait(lock, [this]() { return hasMessage() || isShutdown(); });
+    m_consumerParked.store(false, std::memory_order_relaxed);
+}
+
+void MessageQueue::wakeConsumer() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_consumerParked.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(m_parkMutex);
+        m_parkCondVar.notify_one(); // Notify a readied consumer
+    }
+}
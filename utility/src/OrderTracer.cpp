@@ -0,0 +1,218 @@
+#include "OrderTracer.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+#include <tuple>
+
+auto traceStageName(const TraceStage stage) -> const char *
+{
+    switch (stage)
+    {
+    case TraceStage::GATEWAY_READ:
+        return "gateway_read";
+    case TraceStage::QUEUE_PUSH:
+        return "queue_push";
+    case TraceStage::DEQUEUE:
+        return "dequeue";
+    case TraceStage::MATCH_BEGIN:
+        return "match";
+    case TraceStage::MATCH_END:
+        return "match_end";
+    case TraceStage::ACK_QUEUED:
+        return "ack_queued";
+    case TraceStage::ACK_WRITTEN:
+        return "ack_written";
+    default:
+        return "unknown";
+    }
+}
+
+thread_local OrderTracer::ThreadBuffer *OrderTracer::local = nullptr;
+thread_local std::uint32_t OrderTracer::countdown = 0;
+
+auto OrderTracer::getInstance() -> OrderTracer &
+{
+    static OrderTracer instance;
+    return instance;
+}
+
+void OrderTracer::setSampleInterval(const std::uint32_t interval)
+{
+    sampleInterval.store(interval, std::memory_order_relaxed);
+}
+
+auto OrderTracer::getSampleInterval() const -> std::uint32_t
+{
+    return sampleInterval.load(std::memory_order_relaxed);
+}
+
+auto OrderTracer::sample() -> std::uint32_t
+{
+    const std::uint32_t interval = sampleInterval.load(std::memory_order_relaxed);
+    if (interval == 0)
+    {
+        return 0;
+    }
+    // A countdown above the interval is left from a larger interval, the next message is sampled then
+    if (countdown > 1 && countdown <= interval)
+    {
+        --countdown;
+        return 0;
+    }
+    countdown = interval;
+    std::uint32_t traceId = nextTraceId.fetch_add(1, std::memory_order_relaxed);
+    if (traceId == 0)
+    {
+        traceId = nextTraceId.fetch_add(1, std::memory_order_relaxed);
+    }
+    return traceId;
+}
+
+void OrderTracer::recordSampled(const std::uint32_t traceId, const TraceStage stage, const Timestamp timestamp)
+{
+    ThreadBuffer &buffer = localBuffer();
+    const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    ThreadBuffer::Slot &slot = buffer.slots[index & (ThreadBuffer::CAPACITY - 1)];
+    slot.timestamp.store(timestamp, std::memory_order_relaxed);
+    slot.tag.store(static_cast<std::uint64_t>(traceId) << 8 | static_cast<std::uint64_t>(stage), std::memory_order_relaxed);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+auto OrderTracer::localBuffer() -> ThreadBuffer &
+{
+    if (local == nullptr)
+    {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        local = buffer.get();
+        std::lock_guard<std::mutex> lock(threadsMutex);
+        threadBuffers.push_back(std::move(buffer));
+    }
+    return *local;
+}
+
+auto OrderTracer::collect() const -> std::vector<TraceEvent>
+{
+    std::vector<TraceEvent> events;
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    for (std::size_t thread = 0; thread < threadBuffers.size(); ++thread)
+    {
+        const ThreadBuffer &buffer = *threadBuffers[thread];
+        const std::uint64_t written = buffer.written.load(std::memory_order_acquire);
+        const std::uint64_t first = written > ThreadBuffer::CAPACITY ? written - ThreadBuffer::CAPACITY : 0;
+        std::vector<TraceEvent> copied;
+        copied.reserve(static_cast<std::size_t>(written - first));
+        for (std::uint64_t index = first; index < written; ++index)
+        {
+            const ThreadBuffer::Slot &slot = buffer.slots[index & (ThreadBuffer::CAPACITY - 1)];
+            const std::uint64_t tag = slot.tag.load(std::memory_order_relaxed);
+            copied.push_back({slot.timestamp.load(std::memory_order_relaxed), static_cast<std::uint32_t>(tag >> 8),
+                              static_cast<TraceStage>(tag & 0xFF), thread});
+        }
+
+        // The writer may have lapped the copy: everything up to one ring behind its position is suspect,
+        // including the slot it may be writing right now
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t writtenAfter = buffer.written.load(std::memory_order_relaxed);
+        const std::uint64_t validFrom =
+            writtenAfter + 1 > ThreadBuffer::CAPACITY ? std::max(first, writtenAfter + 1 - ThreadBuffer::CAPACITY) : first;
+        for (std::uint64_t index = validFrom; index < written; ++index)
+        {
+            // A trace ID of 0 is a slot cleared by reset
+            if (const TraceEvent &event = copied[static_cast<std::size_t>(index - first)]; event.traceId != 0)
+            {
+                events.push_back(event);
+            }
+        }
+    }
+    return events;
+}
+
+auto OrderTracer::writeChromeTrace(std::ostream &out) const -> std::size_t
+{
+    std::vector<TraceEvent> events = collect();
+    std::sort(events.begin(), events.end(), [](const TraceEvent &lhs, const TraceEvent &rhs)
+              { return std::tie(lhs.traceId, lhs.timestamp, lhs.stage) < std::tie(rhs.traceId, rhs.timestamp, rhs.stage); });
+
+    Timestamp origin = 0;
+    std::size_t threadCount = 0;
+    if (!events.empty())
+    {
+        origin = std::min_element(events.begin(), events.end(), [](const TraceEvent &lhs, const TraceEvent &rhs)
+                                  { return lhs.timestamp < rhs.timestamp; })->timestamp;
+        for (const TraceEvent &event : events)
+        {
+            threadCount = std::max(threadCount, event.thread + 1);
+        }
+    }
+    const auto microseconds = [origin](const Timestamp timestamp)
+    { return ticksToNanoseconds(timestamp - origin) / 1000.0; };
+
+    out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+    out << std::fixed << std::setprecision(3);
+    bool firstEvent = true;
+    const auto separator = [&out, &firstEvent]()
+    {
+        out << (firstEvent ? "\n" : ",\n");
+        firstEvent = false;
+    };
+
+    for (std::size_t thread = 0; thread < threadCount; ++thread)
+    {
+        separator();
+        out << R"({"name":"thread_name","ph":"M","pid":1,"tid":)" << thread
+            << R"(,"args":{"name":"thread )" << thread << R"("}})";
+    }
+
+    // Each stamp opens a span that lasts until the next stamp of the same order, the last one is an instant
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < events.size(); ++i)
+    {
+        const TraceEvent &event = events[i];
+        const bool hasNext = i + 1 < events.size() && events[i + 1].traceId == event.traceId;
+        separator();
+        out << R"({"name":")" << traceStageName(event.stage) << R"(","cat":"order","pid":1,"tid":)" << event.thread
+            << R"(,"ts":)" << microseconds(event.timestamp);
+        if (hasNext)
+        {
+            out << R"(,"ph":"X","dur":)" << microseconds(events[i + 1].timestamp) - microseconds(event.timestamp);
+        }
+        else
+        {
+            out << R"(,"ph":"i","s":"t")";
+        }
+        out << R"(,"args":{"trace_id":)" << event.traceId << "}}";
+        ++written;
+    }
+    out << "\n]}\n";
+    return written;
+}
+
+auto OrderTracer::dump(const std::string &path) const -> std::size_t
+{
+    std::ofstream file(path, std::ios::trunc);
+    if (!file)
+    {
+        throw std::runtime_error("Cannot open trace file: " + path);
+    }
+    const std::size_t written = writeChromeTrace(file);
+    file.flush();
+    if (!file)
+    {
+        throw std::runtime_error("Cannot write trace file: " + path);
+    }
+    return written;
+}
+
+void OrderTracer::reset()
+{
+    std::lock_guard<std::mutex> lock(threadsMutex);
+    for (const auto &buffer : threadBuffers)
+    {
+        // Only the owning thread writes positions, so events are dropped by clearing the tags instead
+        for (ThreadBuffer::Slot &slot : buffer->slots)
+        {
+            slot.tag.store(0, std::memory_order_relaxed);
+        }
+    }
+}
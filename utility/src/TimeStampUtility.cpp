@@ -3,6 +3,117 @@
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include "utility_config.hpp"
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace
+{
+    struct ClockCalibration
+    {
+        bool tsc = false;
+        double nanosecondsPerTick = 1.0;
+        Timestamp anchorTicks = 0;               // Clock reading taken together with anchorWallNanoseconds
+        std::int64_t anchorWallNanoseconds = 0;  // Since the system_clock epoch
+    };
+
+    auto steadyNanoseconds() -> Timestamp
+    {
+        // CLOCK_MONOTONIC on Linux, answered by the vDSO
+        return static_cast<Timestamp>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Constant rate TSC that keeps counting in deep C-states (CPUID 0x80000007, EDX bit 8)
+    auto hasInvariantTsc() -> bool
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 || eax < 0x80000007)
+        {
+            return false;
+        }
+        __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+        return (edx & (1U << 8)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    auto readClock(const bool tsc) -> Timestamp
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        if (tsc)
+        {
+            return __rdtsc();
+        }
+#endif
+        return steadyNanoseconds();
+    }
+
+    auto calibrate() -> ClockCalibration
+    {
+        ClockCalibration result;
+        result.tsc = hasInvariantTsc();
+        if (result.tsc)
+        {
+            const auto steadyStart = std::chrono::steady_clock::now();
+            const Timestamp ticksStart = readClock(true);
+            const auto until = steadyStart + std::chrono::milliseconds(Utility_Config::Clock::CALIBRATION_MS);
+            auto steadyEnd = steadyStart;
+            while ((steadyEnd = std::chrono::steady_clock::now()) < until)
+            {
+            }
+            const Timestamp ticksEnd = readClock(true);
+            result.nanosecondsPerTick = std::chrono::duration<double, std::nano>(steadyEnd - steadyStart).count() /
+                                        static_cast<double>(ticksEnd - ticksStart);
+        }
+
+        // The wall clock read is bracketed by two clock readings and paired with their midpoint
+        const Timestamp before = readClock(result.tsc);
+        const auto wall = std::chrono::system_clock::now();
+        const Timestamp after = readClock(result.tsc);
+        result.anchorTicks = before + (after - before) / 2;
+        result.anchorWallNanoseconds =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(wall.time_since_epoch()).count();
+        return result;
+    }
+
+    auto calibration() -> const ClockCalibration &
+    {
+        static const ClockCalibration instance = calibrate();
+        return instance;
+    }
+}
+
+auto monotonicNow() -> Timestamp
+{
+    const Timestamp ticks = readClock(calibration().tsc);
+    return ticks != 0 ? ticks : 1;
+}
+
+auto isTscClock() -> bool
+{
+    return calibration().tsc;
+}
+
+auto ticksToNanoseconds(const Timestamp ticks) -> double
+{
+    return static_cast<double>(ticks) * calibration().nanosecondsPerTick;
+}
+
+auto toWallClock(const Timestamp timestamp) -> std::chrono::system_clock::time_point
+{
+    const ClockCalibration &clock = calibration();
+    // Signed distance from the anchor, readings taken before calibration are valid too
+    const auto sinceAnchor = static_cast<std::int64_t>(timestamp - clock.anchorTicks);
+    const auto wallNanoseconds = clock.anchorWallNanoseconds +
+                                 static_cast<std::int64_t>(static_cast<double>(sinceAnchor) * clock.nanosecondsPerTick);
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(wallNanoseconds)));
+}
 
 auto timestampToString(const std::chrono::system_clock::time_point &timestamp) -> std::string
 {
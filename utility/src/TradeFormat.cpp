@@ -2,76 +2,29 @@
 #include <chrono>
 #include <sstream>
 #include <iomanip>
-#include "Trade.h"
+#include <stdexcept>
+#include "TradeFormat.h"
 #include "utility_config.hpp"
 #include "TimestampUtility.h"
 
-Trade::Trade(const unsigned int trade_id, const unsigned int buy_order_id, const unsigned int sell_order_id, std::string  asset, const double price, const int quantity) : trade_id(trade_id), buy_order_id(buy_order_id), sell_order_id(sell_order_id),
-                                                                                                                       asset(std::move(asset)), price(price), quantity(quantity), timestamp(currentTimestamp()),
-                                                                                                                       buyOrderStatus(TradeStatus::UNDEFINED), sellOrderStatus(TradeStatus::UNDEFINED) {}
-
-auto Trade::getAsset() const -> const std::string &
-{
-    return asset;
-}
-
-auto Trade::getTradeId() const -> unsigned int
-{
-    return trade_id;
-}
-
-auto Trade::getBuyOrderId() const -> unsigned int
-{
-    return buy_order_id;
-}
-
-auto Trade::getSellOrderId() const -> unsigned int
-{
-    return sell_order_id;
-}
-
-auto Trade::getPrice() const -> double
-{
-    return price;
-}
-
-auto Trade::getTradeValue() const -> double
-{
-    return price * quantity;
-}
-
-auto Trade::getQuantity() const -> int
-{
-    return quantity;
-}
-
-auto Trade::getBuyOrderStatus() const -> TradeStatus
-{
-    return buyOrderStatus;
-}
-
-auto Trade::getSellOrderStatus() const -> TradeStatus
-{
-    return sellOrderStatus;
-}
-
-void Trade::setBuyOrderStatus(TradeStatus status)
-{
-    this->buyOrderStatus = status;
-}
-
-void Trade::setSellOrderStatus(TradeStatus status)
-{
-    this->sellOrderStatus = status;
-}
-
-auto Trade::getTimestamp() const -> std::chrono::system_clock::time_point
+auto getTradeValue(const Trade &trade) -> double
 {
-    return timestamp;
+    return InstrumentRegistry::getInstance().toDouble(trade.getInstrument(), trade.getPrice()) * trade.getQuantity();
 }
 
-auto Trade::toString(const std::string& format) const -> std::string {
+auto formatTrade(const Trade &trade, const std::string& format) -> std::string {
     std::ostringstream oss;
+    const InstrumentRegistry &registry = InstrumentRegistry::getInstance();
+    const std::string &asset = registry.getSymbol(trade.getInstrument());
+    const double displayPrice = registry.toDouble(trade.getInstrument(), trade.getPrice());
+    const double tradeValue = getTradeValue(trade);
+    const unsigned int trade_id = trade.getTradeId();
+    const unsigned int buy_order_id = trade.getBuyOrderId();
+    const unsigned int sell_order_id = trade.getSellOrderId();
+    const int quantity = trade.getQuantity();
+    const TradeStatus buyOrderStatus = trade.getBuyOrderStatus();
+    const TradeStatus sellOrderStatus = trade.getSellOrderStatus();
+    const auto timestamp = trade.getTimestamp();
 
     if (format == "default") {
         auto appendField = [&oss](const std::string& label, const auto& value, bool format = false) {
@@ -88,9 +41,9 @@ auto Trade::toString(const std::string& format) const -> std::string {
         appendField("Buy Order ID: ", buy_order_id);
         appendField("Sell Order ID: ", sell_order_id);
         appendField("Asset: ", asset);
-        appendField("Price: ", price, true);
+        appendField("Price: ", displayPrice, true);
         appendField("Quantity: ", quantity);
-        appendField("Trade Value: ", getTradeValue(), true);
+        appendField("Trade Value: ", tradeValue, true);
         appendField("Buy Order Status: ", static_cast<int>(buyOrderStatus));
         appendField("Sell Order Status: ", static_cast<int>(sellOrderStatus));
         appendField("Timestamp: ", timestampToString(timestamp));
@@ -100,9 +53,9 @@ auto Trade::toString(const std::string& format) const -> std::string {
             << "\"BuyOrderID\":" << buy_order_id << ","
             << "\"SellOrderID\":" << sell_order_id << ","
             << R"("Asset":")" << asset << "\","
-            << "\"Price\":" << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << price << ","
+            << "\"Price\":" << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << displayPrice << ","
             << "\"Quantity\":" << quantity << ","
-            << "\"TradeValue\":" << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << getTradeValue() << ","
+            << "\"TradeValue\":" << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << tradeValue << ","
             << "\"BuyOrderStatus\":" << static_cast<int>(buyOrderStatus) << ","
             << "\"SellOrderStatus\":" << static_cast<int>(sellOrderStatus) << ","
             << R"("Timestamp":")" << timestampToString(timestamp) << "\""
@@ -112,9 +65,9 @@ auto Trade::toString(const std::string& format) const -> std::string {
             << buy_order_id << ","
             << sell_order_id << ","
             << asset << ","
-            << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << price << ","
+            << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << displayPrice << ","
             << quantity << ","
-            << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << getTradeValue() << ","
+            << std::fixed << std::setprecision(Utility_Config::Trade::DEFAULT_PRECISION_DISPLAY) << tradeValue << ","
             << static_cast<int>(buyOrderStatus) << ","
             << static_cast<int>(sellOrderStatus) << ","
             << timestampToString(timestamp);
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "Logger.hpp"
+#include "TradeLog.h"
+
+namespace
+{
+    constexpr char MAGIC[8] = {'M', 'E', 'T', 'R', 'A', 'D', 'E', 'S'};
+    constexpr std::uint32_t VERSION = 3;
+}
+
+TradeLog::TradeLog(const std::string &path, const std::size_t initialCapacity, const std::size_t reservedSize)
+    : path(path), initialCapacity(std::max<std::size_t>(initialCapacity, 1)), reservedSize(reservedSize),
+      file(std::make_unique<MappedFile>(prepareLogFile(path, MAGIC, VERSION, sizeof(Trade)),
+                                        sizeof(Header) + this->initialCapacity * sizeof(Trade), reservedSize))
+{
+    // prepareLogFile left either a log of this layout or a new file
+    startHeader();
+    grower = std::thread(&TradeLog::growLoop, this);
+}
+
+TradeLog::~TradeLog()
+{
+    {
+        std::lock_guard<std::mutex> lock(growMutex);
+        stopping = true;
+    }
+    growSignal.notify_one();
+    grower.join();
+}
+
+void TradeLog::append(const Trade &trade)
+{
+    std::size_t count = size();
+    const std::size_t available = capacity();
+    if (count == available)
+    {
+        // The grower is behind, or failed, or the file reached its reserved size
+        makeRoom();
+        count = size();
+    }
+    else if (2 * count >= available && requestedCapacity <= available && file->size() < file->getReservedSize())
+    {
+        requestedCapacity = 2 * available;
+        {
+            std::lock_guard<std::mutex> lock(growMutex);
+            growTarget = doubledSize();
+            growFile = file.get();
+        }
+        growSignal.notify_one();
+    }
+    std::memcpy(static_cast<void *>(records() + count), &trade, sizeof(Trade));
+    header()->recordCount = count + 1;
+}
+
+auto TradeLog::size() const -> std::size_t
+{
+    return header()->recordCount;
+}
+
+auto TradeLog::empty() const -> bool
+{
+    return size() == 0;
+}
+
+auto TradeLog::at(const std::size_t index) const -> const Trade &
+{
+    if (index >= size())
+    {
+        throw std::out_of_range("Trade log index out of range.");
+    }
+    return records()[index];
+}
+
+auto TradeLog::begin() const -> const_iterator
+{
+    return const_iterator(records());
+}
+
+auto TradeLog::end() const -> const_iterator
+{
+    return const_iterator(records() + size());
+}
+
+auto TradeLog::lowerBound(const unsigned int tradeId) const -> const_iterator
+{
+    return std::lower_bound(begin(), end(), tradeId,
+                            [](const Trade &trade, const unsigned int id) { return trade.getTradeId() < id; });
+}
+
+void TradeLog::sync() const
+{
+    file->sync();
+}
+
+auto TradeLog::getPath() const -> const std::string &
+{
+    return path;
+}
+
+auto TradeLog::header() const -> Header *
+{
+    return reinterpret_cast<Header *>(file->data());
+}
+
+auto TradeLog::records() const -> Trade *
+{
+    return reinterpret_cast<Trade *>(file->data() + sizeof(Header));
+}
+
+auto TradeLog::capacity() const -> std::size_t
+{
+    return (file->size() - sizeof(Header)) / sizeof(Trade);
+}
+
+auto TradeLog::doubledSize() const -> std::size_t
+{
+    return std::min(sizeof(Header) + 2 * capacity() * sizeof(Trade), file->getReservedSize());
+}
+
+void TradeLog::startHeader()
+{
+    Header *head = header();
+    if (std::memcmp(head->magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        std::memcpy(head->magic, MAGIC, sizeof(MAGIC));
+        head->version = VERSION;
+        head->recordSize = sizeof(Trade);
+        head->recordCount = 0;
+    }
+}
+
+void TradeLog::makeRoom()
+{
+    if (file->size() < file->getReservedSize())
+    {
+        file->grow(doubledSize());
+    }
+    if (capacity() == size())
+    {
+        rollOver();
+    }
+}
+
+void TradeLog::rollOver()
+{
+    // Once per reserved size worth of trades, the only time the appending thread opens a file
+    auto next = std::make_unique<MappedFile>(startNewLogFile(path, "filled the address space reserved for a trade log"),
+                                             sizeof(Header) + initialCapacity * sizeof(Trade), reservedSize);
+    retired.push_back(std::move(file));
+    file = std::move(next);
+    startHeader();
+    requestedCapacity = 0;
+}
+
+void TradeLog::growLoop()
+{
+    std::unique_lock<std::mutex> lock(growMutex);
+    while (true)
+    {
+        growSignal.wait(lock, [this]() { return stopping || growTarget != 0; });
+        if (stopping)
+        {
+            return;
+        }
+        const std::size_t target = growTarget;
+        MappedFile *growing = growFile;
+        growTarget = 0;
+        lock.unlock();
+        try
+        {
+            growing->grow(target);
+        }
+        catch (const std::exception &e)
+        {
+            // The file stays mapped at its old size, the appending thread retries once it is full
+            Logger::getLogger()->error(e.what());
+        }
+        lock.lock();
+    }
+}